@@ -0,0 +1,231 @@
+#!/usr/bin/env node
+// Headless benchmark for the allocation algorithms in project.html.
+//
+// Loads the DOM-free <script id="simulation-engine"> block straight out of the
+// page, so the numbers always come from the same code the browser runs, and
+// drives every algorithm over an identical seeded workload with no timers,
+// rendering or logging in the way.
+//
+//   node benchmark.js [options]
+//
+//   --sizes 10,100,1000      initial process counts to run (default 10 ... 1000000)
+//   --algorithms a,b         subset of adaptive,roundrobin,priority,fcfs,backfill
+//   --seed N                 workload seed (default 1)
+//   --max-ticks N            stop a run after N simulated ticks (default 20000)
+//   --cpu N --memory N --io N  system resources (defaults match the page)
+//   --arrival-every N        add one random process every N ticks (default 0 = off)
+//   --mix c,m,i,b            relative weights of the processTypes mix
+//   --deadlock on|avoid|off  deadlock detection, plus Banker's avoidance (default on)
+//   --page FILE              page to load the engine from (default project.html)
+//   --trace FILE             record the run as a binary trace (one size and algorithm only)
+//   --profile FILE           write per-phase tick timings as folded stacks, one root per algorithm
+//   --json                   print results as JSON instead of a table
+
+const fs = require("fs");
+const path = require("path");
+const vm = require("vm");
+
+const ALGORITHMS = ["adaptive", "roundrobin", "priority", "fcfs", "backfill"];
+const DEADLOCK_MODES = ["on", "avoid", "off"];
+
+const DEFAULTS = {
+    sizes: [10, 100, 1000, 10000, 100000, 1000000],
+    algorithms: ALGORITHMS,
+    seed: 1,
+    maxTicks: 20000,
+    cpu: 2,
+    memory: 512,
+    io: 3,
+    arrivalEvery: 0,
+    mix: null,
+    deadlock: "on",
+    page: path.join(__dirname, "project.html"),
+    trace: null,
+    profile: null,
+    json: false
+};
+
+// Evaluate the page's engine block in a fresh context and return its exports
+function loadEngine(pagePath) {
+    const html = fs.readFileSync(pagePath, "utf8");
+    const match = html.match(/<script id="simulation-engine">([\s\S]*?)<\/script>/);
+    if (!match) {
+        throw new Error(`No <script id="simulation-engine"> block in ${pagePath}`);
+    }
+
+    const context = vm.createContext({ Math, Map, Set, Array, Object, Infinity, TextEncoder, TextDecoder, performance });
+    return vm.runInContext(
+        match[1] + "\n;({ SimulationEngine, createRandom, processTypes, TraceWriter, TraceReader, TraceReplay, PhaseProfiler });",
+        context,
+        { filename: pagePath }
+    );
+}
+
+// Run one algorithm over one seeded workload and collect its metrics.
+// `inspect(engine)`, if given, is called on the finished engine;
+// `instruments.trace` (a TraceWriter) records the run and
+// `instruments.profiler` (a PhaseProfiler) times its ticks.
+function runSimulation(engineModule, config, algorithm, size, inspect, instruments = {}) {
+    const { SimulationEngine } = engineModule;
+    const engine = new SimulationEngine({
+        cpu: config.cpu,
+        memory: config.memory,
+        io: config.io,
+        seed: config.seed,
+        profiler: instruments.profiler
+    });
+    if (instruments.trace) engine.startTrace(instruments.trace);
+
+    for (let i = 0; i < size; i++) {
+        engine.addRandomProcess(config.mix);
+    }
+
+    const counts = engine.scheduler.counts;
+    const resources = engine.resources;
+    const busy = { cpu: 0, memory: 0, io: 0 };
+    const start = process.hrtime.bigint();
+    while (engine.time < config.maxTicks) {
+        if (config.arrivalEvery > 0 && (engine.time + 1) % config.arrivalEvery === 0) {
+            engine.addRandomProcess(config.mix);
+        } else if (config.arrivalEvery === 0 && counts.waiting === 0 && counts.running === 0) {
+            break; // Drained
+        }
+        engine.step(algorithm, config.deadlock);
+        busy.cpu += resources.allocatedCPU;
+        busy.memory += resources.allocatedMemory;
+        busy.io += resources.allocatedIO;
+    }
+    const seconds = Number(process.hrtime.bigint() - start) / 1e9;
+    if (instruments.trace) instruments.trace.end(engine.time);
+    if (inspect) inspect(engine);
+
+    const stats = engine.stats;
+    const total = engine.processes.length;
+    const waits = Float64Array.from(engine.processes, process => engine.scheduler.waitTimeOf(process)).sort();
+    const utilization = (used, capacity) => engine.time > 0 ? used / (capacity * engine.time) : 0;
+    return {
+        algorithm,
+        size,
+        ticks: engine.time,
+        processes: total,
+        completed: stats.completed,
+        terminated: counts.terminated,
+        throughputPerMin: engine.time > 0 ? (stats.completed / engine.time) * 60 : 0,
+        avgWait: total > 0 ? engine.scheduler.totalWaitTime() / total : 0,
+        p99Wait: total > 0 ? waits[Math.ceil(total * 0.99) - 1] : 0,
+        avgTurnaround: stats.completed > 0 ? stats.totalTurnaroundTime / stats.completed : 0,
+        contextSwitches: stats.contextSwitches,
+        deadlocks: stats.deadlocks,
+        utilization: {
+            cpu: utilization(busy.cpu, resources.cpu),
+            memory: utilization(busy.memory, resources.memory),
+            io: utilization(busy.io, resources.io)
+        },
+        deferred: Object.assign({}, stats.deferred),
+        wallSeconds: seconds,
+        ticksPerSecond: seconds > 0 ? engine.time / seconds : Infinity
+    };
+}
+
+function parseArgs(argv) {
+    const config = Object.assign({}, DEFAULTS);
+    const list = value => value.split(",").filter(item => item !== "");
+
+    for (let i = 0; i < argv.length; i++) {
+        const flag = argv[i];
+        const value = argv[i + 1];
+        switch (flag) {
+            case "--sizes": config.sizes = list(value).map(Number); i++; break;
+            case "--algorithms": config.algorithms = list(value); i++; break;
+            case "--seed": config.seed = Number(value); i++; break;
+            case "--max-ticks": config.maxTicks = Number(value); i++; break;
+            case "--cpu": config.cpu = Number(value); i++; break;
+            case "--memory": config.memory = Number(value); i++; break;
+            case "--io": config.io = Number(value); i++; break;
+            case "--arrival-every": config.arrivalEvery = Number(value); i++; break;
+            case "--mix": config.mix = list(value).map(Number); i++; break;
+            case "--deadlock": config.deadlock = value; i++; break;
+            case "--page": config.page = value; i++; break;
+            case "--trace": config.trace = value; i++; break;
+            case "--profile": config.profile = value; i++; break;
+            case "--json": config.json = true; break;
+            default:
+                throw new Error(`Unknown option ${flag}`);
+        }
+    }
+
+    config.algorithms.forEach(algorithm => {
+        if (!ALGORITHMS.includes(algorithm)) throw new Error(`Unknown algorithm ${algorithm}`);
+    });
+    if (!DEADLOCK_MODES.includes(config.deadlock)) throw new Error(`Unknown deadlock mode ${config.deadlock}`);
+    if (config.trace && config.sizes.length * config.algorithms.length !== 1) {
+        throw new Error("--trace records a single run; pass one size and one algorithm");
+    }
+    return config;
+}
+
+// Grants held back for any reason
+function deferredTotal(deferred) {
+    return Object.keys(deferred).reduce((sum, reason) => sum + deferred[reason], 0);
+}
+
+function formatTable(results) {
+    const columns = [
+        ["algorithm", "Algorithm", r => r.algorithm],
+        ["size", "Procs", r => r.size],
+        ["ticks", "Ticks", r => r.ticks],
+        ["completed", "Done", r => r.completed],
+        ["throughput", "Thru/min", r => r.throughputPerMin.toFixed(1)],
+        ["wait", "AvgWait", r => r.avgWait.toFixed(1)],
+        ["p99wait", "P99Wait", r => r.p99Wait],
+        ["turnaround", "AvgTurn", r => r.avgTurnaround.toFixed(1)],
+        ["switches", "CtxSw", r => r.contextSwitches],
+        ["cpu", "CPU%", r => (r.utilization.cpu * 100).toFixed(1)],
+        ["memory", "Mem%", r => (r.utilization.memory * 100).toFixed(1)],
+        ["io", "IO%", r => (r.utilization.io * 100).toFixed(1)],
+        ["deadlocks", "Dlk", r => r.deadlocks],
+        ["deferred", "Deferred", r => deferredTotal(r.deferred)],
+        ["unsafe", "Unsafe", r => r.deferred.unsafe],
+        ["tps", "Ticks/s", r => Math.round(r.ticksPerSecond)]
+    ];
+    const rows = [columns.map(column => column[1])]
+        .concat(results.map(result => columns.map(column => String(column[2](result)))));
+    const widths = columns.map((column, index) => Math.max(...rows.map(row => row[index].length)));
+
+    return rows
+        .map(row => row.map((cell, index) => index === 0 ? cell.padEnd(widths[index]) : cell.padStart(widths[index])).join("  "))
+        .join("\n");
+}
+
+function main() {
+    const config = parseArgs(process.argv.slice(2));
+    const engineModule = loadEngine(config.page);
+    const results = [];
+    const profiles = [];
+
+    // Trace chunks go straight to disk as they fill
+    const traceFile = config.trace ? fs.openSync(config.trace, "w") : null;
+    const trace = traceFile !== null ? new engineModule.TraceWriter(chunk => fs.writeSync(traceFile, chunk)) : null;
+
+    config.sizes.forEach(size => {
+        config.algorithms.forEach(algorithm => {
+            const profiler = config.profile ? new engineModule.PhaseProfiler() : null;
+            const result = runSimulation(engineModule, config, algorithm, size, null, { trace: trace, profiler: profiler });
+            if (profiler) profiles.push(profiler.folded(algorithm));
+            results.push(result);
+            if (!config.json) {
+                process.stderr.write(`${algorithm} x ${size}: ${result.ticks} ticks in ${result.wallSeconds.toFixed(2)}s\n`);
+            }
+        });
+    });
+
+    if (traceFile !== null) fs.closeSync(traceFile);
+    if (config.profile) fs.writeFileSync(config.profile, profiles.filter(text => text !== "").join("\n") + "\n");
+    console.log(config.json ? JSON.stringify({ config, results }, null, 2) : formatTable(results));
+}
+
+module.exports = { ALGORITHMS, DEADLOCK_MODES, DEFAULTS, loadEngine, runSimulation, parseArgs, deferredTotal };
+
+if (require.main === module) {
+    main();
+}
@@ -0,0 +1,114 @@
+#!/usr/bin/env node
+// Hold-and-wait scenarios for the resource-allocation graph in project.html.
+//
+// Grants are all-or-nothing, so no run of the simulator ever leaves a waiting
+// process holding resources and the graph's cycle detection and Banker's
+// check never fire in benchmark.js or sweep.js. These scenarios hand the
+// graph partial holdings directly, on the engine loaded from the page, and
+// check that it finds (and the engine breaks) a real deadlock, leaves a
+// merely blocked state alone and refuses an unsafe grant. The exit status is
+// 1 if any check fails.
+//
+//   node deadlock.js [--page FILE]
+
+const path = require("path");
+const { loadEngine } = require("./benchmark");
+
+const RESOURCES = { cpu: 2, memory: 512, io: 3 };
+
+function parseArgs(argv) {
+    const config = { page: path.join(__dirname, "project.html") };
+    for (let i = 0; i < argv.length; i += 2) {
+        if (argv[i] !== "--page") throw new Error(`Unknown option ${argv[i]}`);
+        config.page = argv[i + 1];
+    }
+    return config;
+}
+
+function newEngine(engineModule) {
+    return new engineModule.SimulationEngine(Object.assign({ seed: 1 }, RESOURCES));
+}
+
+function addProcess(engine, name, priority, cpuNeed, memoryNeed, ioNeed) {
+    return engine.addProcess({ name, type: "Balanced", priority, cpuNeed, memoryNeed, ioNeed, burstTime: 5 });
+}
+
+// Give a waiting process part of what it asked for, as a partial grant would
+function hold(engine, process, cpu, memory, io) {
+    process.cpuAllocated = cpu;
+    process.memoryAllocated = memory;
+    process.ioAllocated = io;
+    engine.resources.allocatedCPU += cpu;
+    engine.resources.allocatedMemory += memory;
+    engine.resources.allocatedIO += io;
+    engine.scheduler.graph.request(process);
+}
+
+// A holds a core and half the memory and wants the other core; B holds the
+// other core and the other half and wants more memory
+function deadlockedPair(engineModule) {
+    const engine = newEngine(engineModule);
+    const a = addProcess(engine, "A", 2, 2, 256, 1);
+    const b = addProcess(engine, "B", 7, 1, 512, 1);
+    hold(engine, a, 1, 256, 0);
+    hold(engine, b, 1, 256, 0);
+    return { engine, a, b };
+}
+
+const scenarios = [
+    ["blocked holder that can still finish is not a deadlock", engineModule => {
+        const engine = newEngine(engineModule);
+        const a = addProcess(engine, "A", 5, 2, 256, 1);
+        hold(engine, a, 1, 256, 0);
+        const graph = engine.scheduler.graph;
+        return [
+            ["A is a suspect (it holds and requests cpu)", graph.suspects.has(a)],
+            ["no deadlock detected", engine.checkForDeadlocks() === false],
+            ["suspects cleared once the holder reduces", graph.suspects.size === 0],
+            ["granting A is safe", engine.bankersCheck(a) === true]
+        ];
+    }],
+    ["hold-and-wait cycle is detected and broken", engineModule => {
+        const { engine, a, b } = deadlockedPair(engineModule);
+        const deadlocked = engine.scheduler.graph.detect();
+        const broken = engine.checkForDeadlocks();
+        return [
+            ["detect() reports both processes", deadlocked.length === 2 && deadlocked.includes(a) && deadlocked.includes(b)],
+            ["checkForDeadlocks() breaks it", broken === true && engine.stats.deadlocks === 1],
+            ["lowest priority process is the victim", a.status === "terminated" && b.status === "waiting"],
+            ["victim's holdings are returned", engine.resources.allocatedCPU === 1 && engine.resources.allocatedMemory === 256],
+            ["no deadlock remains", engine.scheduler.graph.detect().length === 0 && engine.checkForDeadlocks() === false]
+        ];
+    }],
+    ["Banker's check refuses grants while the holders cannot finish", engineModule => {
+        const { engine, a, b } = deadlockedPair(engineModule);
+        const c = addProcess(engine, "C", 5, 1, 50, 1);
+        const unsafeBefore = engine.bankersCheck(c) === false;
+        const resolvesCycle = engine.bankersCheck(a) === true;
+        engine.scheduler.terminate(b);
+        return [
+            ["granting an outsider is unsafe", unsafeBefore],
+            ["granting a process on the cycle is safe", resolvesCycle],
+            ["granting the outsider is safe once the cycle is gone", engine.bankersCheck(c) === true]
+        ];
+    }]
+];
+
+function main() {
+    const config = parseArgs(process.argv.slice(2));
+    const engineModule = loadEngine(config.page);
+    let failures = 0;
+    scenarios.forEach(([title, run]) => {
+        console.log(title);
+        run(engineModule).forEach(([check, passed]) => {
+            if (!passed) failures++;
+            console.log(`  ${passed ? "ok  " : "FAIL"} ${check}`);
+        });
+    });
+    if (failures > 0) {
+        console.log(`${failures} checks failed`);
+        process.exitCode = 1;
+    }
+}
+
+main();
@@ -173,6 +173,11 @@
             margin-top: 15px;
         }
 
+        .process-list, .responsive-table.virtual {
+            max-height: 500px;
+            overflow-y: auto;
+        }
+
         .process-item, .resource-item {
             background: var(--light-bg);
             padding: 12px 15px;
@@ -211,6 +216,9 @@
         .process-name {
             font-weight: 600;
             color: var(--primary-color);
+            white-space: nowrap;
+            overflow: hidden;
+            text-overflow: ellipsis;
         }
 
         .process-status {
@@ -480,6 +488,7 @@
                     <h3 id="simulation-time">Time: 0s</h3>
                     <p>CPU Utilization: <span id="cpu-util">0%</span></p>
                     <p>Processes: <span id="total-processes">0</span></p>
+                    <p>Frame: <span id="frame-time">0.0ms</span> | Tick drift: <span id="tick-drift">0.0ms</span></p>
                 </div>
             </div>
         </header>
@@ -501,6 +510,7 @@
                             <option value="roundrobin">Round Robin</option>
                             <option value="priority">Priority Based</option>
                             <option value="fcfs">First Come First Serve</option>
+                            <option value="backfill">Backfilling (Multi-Resource Packing)</option>
                             <option value="multilevel">Multilevel Queue</option>
                         </select>
                     </div>
@@ -541,6 +551,7 @@
                         <label for="deadlock-detection">Deadlock Detection</label>
                         <select id="deadlock-detection">
                             <option value="on">Enabled</option>
+                            <option value="avoid">Enabled + Banker's Avoidance</option>
                             <option value="off">Disabled</option>
                         </select>
                     </div>
@@ -552,6 +563,8 @@
                     <button id="reset-btn" class="btn-danger"><i class="fas fa-redo"></i> Reset</button>
                     <button id="add-process-btn"><i class="fas fa-plus-circle"></i> Add Process</button>
                     <button id="algo-info-btn"><i class="fas fa-info-circle"></i> Algorithm Info</button>
+                    <button id="trace-btn"><i class="fas fa-circle"></i> Record Trace</button>
+                    <button id="profile-btn"><i class="fas fa-fire"></i> Export Profile</button>
                 </div>
 
                 <div class="deadlock-warning" id="deadlock-warning">
@@ -610,6 +623,10 @@
                         <div class="stat-value" id="stat-deadlocks">0</div>
                         <div class="stat-label">Deadlocks</div>
                     </div>
+                    <div class="stat-item">
+                        <div class="stat-value" id="stat-deferred">0</div>
+                        <div class="stat-label">Deferred Grants</div>
+                    </div>
                 </div>
             </div>
 
@@ -644,7 +661,7 @@
 
         <div class="card">
             <h2 class="card-title"><i class="fas fa-table"></i> Allocation Table</h2>
-            <div class="responsive-table">
+            <div class="responsive-table virtual" id="allocation-table-viewport">
                 <table id="allocation-table">
                     <thead>
                         <tr>
@@ -702,73 +719,10 @@
         </footer>
     </div>
 
-    <script>
-        // ==============================
-        // GLOBAL VARIABLES AND CONSTANTS
-        // ==============================
-        let simulationTime = 0;
-        let simulationInterval;
-        let isRunning = false;
-        let processes = [];
-        let resources = {
-            cpu: 2,
-            memory: 512,
-            io: 3,
-            allocatedCPU: 0,
-            allocatedMemory: 0,
-            allocatedIO: 0
-        };
-        let resourceHistory = [];
-        let processStatusCounts = { running: 0, waiting: 0, completed: 0, terminated: 0 };
-        let completedProcesses = 0;
-        let totalWaitTime = 0;
-        let totalTurnaroundTime = 0;
-        let contextSwitches = 0;
-        let pageFaults = 0;
-        let deadlockCount = 0;
-        let autoAddInterval;
-        
-        // Chart instances
-        let resourceChart, processChart;
-        
-        // DOM elements
-        const processCountInput = document.getElementById('process-count');
-        const algorithmSelect = document.getElementById('algorithm');
-        const timeSliceInput = document.getElementById('time-slice');
-        const cpuCountInput = document.getElementById('cpu-count');
-        const memorySizeInput = document.getElementById('memory-size');
-        const ioDevicesInput = document.getElementById('io-devices');
-        const autoAddSelect = document.getElementById('auto-add');
-        const deadlockDetectionSelect = document.getElementById('deadlock-detection');
-        const startBtn = document.getElementById('start-btn');
-        const pauseBtn = document.getElementById('pause-btn');
-        const resetBtn = document.getElementById('reset-btn');
-        const addProcessBtn = document.getElementById('add-process-btn');
-        const algoInfoBtn = document.getElementById('algo-info-btn');
-        const clearLogBtn = document.getElementById('clear-log-btn');
-        const processList = document.getElementById('process-list');
-        const resourceList = document.getElementById('resource-list');
-        const systemLog = document.getElementById('system-log');
-        const simulationTimeElement = document.getElementById('simulation-time');
-        const cpuUtilElement = document.getElementById('cpu-util');
-        const totalProcessesElement = document.getElementById('total-processes');
-        const allocationTableBody = document.getElementById('allocation-table-body');
-        const currentAlgorithmElement = document.getElementById('current-algorithm');
-        const deadlockWarningElement = document.getElementById('deadlock-warning');
-        const algorithmModal = document.getElementById('algorithmModal');
-        const closeModal = document.querySelector('.close-modal');
-        const algorithmDetails = document.getElementById('algorithmDetails');
-        
-        // Metric elements
-        const metricCpuElement = document.getElementById('metric-cpu');
-        const metricMemoryElement = document.getElementById('metric-memory');
-        const metricThroughputElement = document.getElementById('metric-throughput');
-        const metricWaitElement = document.getElementById('metric-wait');
-        
-        // Stat elements
-        const statContextSwitch = document.getElementById('stat-context-switch');
-        const statPageFaults = document.getElementById('stat-page-faults');
-        const statDeadlocks = document.getElementById('stat-deadlocks');
+    <script id="simulation-engine">
+        // Nothing in this block touches the DOM, timers or the log panel, so the
+        // same allocation, execution and deadlock semantics also run headless
+        // (see benchmark.js).
         
         // Process names for random generation
         const processNames = [
@@ -786,481 +740,2151 @@
             { name: "Balanced", cpuMultiplier: 1, memoryMultiplier: 1, ioMultiplier: 1 }
         ];
         
+        // Seeded PRNG (mulberry32) so a workload can be generated again exactly
+        function createRandom(seed) {
+            let state = seed >>> 0;
+            return function() {
+                state = (state + 0x6D2B79F5) >>> 0;
+                let t = state;
+                t = Math.imul(t ^ (t >>> 15), t | 1);
+                t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+                return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+            };
+        }
+        
         // ==============================
-        // INITIALIZATION FUNCTIONS
+        // RESOURCE ALLOCATION GRAPH
         // ==============================
         
-        // Initialize the simulation
-        function initSimulation() {
-            clearInterval(simulationInterval);
-            clearInterval(autoAddInterval);
-            simulationTime = 0;
-            processes = [];
-            completedProcesses = 0;
-            totalWaitTime = 0;
-            totalTurnaroundTime = 0;
-            contextSwitches = 0;
-            pageFaults = 0;
-            deadlockCount = 0;
-            
-            // Set resources based on inputs
-            resources = {
-                cpu: parseInt(cpuCountInput.value),
-                memory: parseInt(memorySizeInput.value),
-                io: parseInt(ioDevicesInput.value),
-                allocatedCPU: 0,
-                allocatedMemory: 0,
-                allocatedIO: 0
-            };
+        // Field names for each resource class, in graph index order
+        const resourceClasses = [
+            { need: "cpuNeed", allocated: "cpuAllocated", total: "cpu", used: "allocatedCPU" },
+            { need: "memoryNeed", allocated: "memoryAllocated", total: "memory", used: "allocatedMemory" },
+            { need: "ioNeed", allocated: "ioAllocated", total: "io", used: "allocatedIO" }
+        ];
+        
+        // Resource-allocation graph over the CPU/memory/IO classes, kept up to
+        // date on every admit, grant and release rather than rebuilt per tick.
+        // Request edges run process -> class for what a process still wants
+        // (`requestMask`), assignment edges class -> process for what it holds.
+        // Only a holder that is also requesting has outgoing edges past a class,
+        // so cycle checks for a new edge walk just those "blocked holders",
+        // indexed by the classes they hold. With B blocked holders a cycle
+        // check is O(B) (each class is expanded at most once) and detect() or
+        // a Banker's check is O(B^2) in the worst case; both are O(1) while
+        // there are no blocked holders, which all-or-nothing grants ensure.
+        class ResourceAllocationGraph {
+            constructor(resources) {
+                this.resources = resources;
+                this.blockedHolders = new Set();
+                // Blocked holders of each class, in graph index order
+                this.holdersOf = resourceClasses.map(() => new Set());
+                // Processes whose new edge closed a cycle; confirmed by detect()
+                this.suspects = new Set();
+            }
             
-            // Generate initial processes
-            const processCount = parseInt(processCountInput.value);
-            for (let i = 0; i < processCount; i++) {
-                addRandomProcess();
+            outstanding(process, k) {
+                const cls = resourceClasses[k];
+                return process[cls.need] - process[cls.allocated];
             }
             
-            // Initialize resource history
-            resourceHistory = [];
-            updateResourceHistory();
+            holds(process, k) {
+                return process[resourceClasses[k].allocated] > 0;
+            }
             
-            // Update UI
-            updateProcessList();
-            updateResourceList();
-            updateAllocationTable();
-            updateMetrics();
-            updateStats();
-            updateCharts();
-            clearLog();
-            addLog("System initialized with " + processCount + " processes", "info");
+            holdsAny(process) {
+                return process.cpuAllocated > 0 || process.memoryAllocated > 0 || process.ioAllocated > 0;
+            }
             
-            // Update simulation time display
-            simulationTimeElement.textContent = "Time: " + simulationTime + "s";
-            totalProcessesElement.textContent = processes.length;
+            // Add request edges for everything the process still needs
+            request(process) {
+                process.requestMask = 0;
+                for (let k = 0; k < resourceClasses.length; k++) {
+                    if (this.outstanding(process, k) > 0) process.requestMask |= 1 << k;
+                }
+                this.track(process);
+                
+                for (let k = 0; k < resourceClasses.length; k++) {
+                    if ((process.requestMask & (1 << k)) && this.classReaches(k, process)) {
+                        this.suspects.add(process);
+                    }
+                }
+            }
             
-            // Hide deadlock warning
-            deadlockWarningElement.style.display = 'none';
-        }
-        
-        // ==============================
-        // PROCESS MANAGEMENT FUNCTIONS
-        // ==============================
-        
-        // Add a random process
-        function addRandomProcess() {
-            const processType = processTypes[Math.floor(Math.random() * processTypes.length)];
-            const name = processNames[Math.floor(Math.random() * processNames.length)];
-            const priority = Math.floor(Math.random() * 10) + 1; // 1-10
-            const cpuNeed = Math.min(Math.floor(Math.random() * resources.cpu * processType.cpuMultiplier) + 1, resources.cpu);
-            const memoryNeed = Math.min(Math.floor(Math.random() * (resources.memory / 4) * processType.memoryMultiplier) + 50, resources.memory);
-            const ioNeed = Math.min(Math.floor(Math.random() * resources.io * processType.ioMultiplier) + 1, resources.io);
-            const burstTime = Math.floor(Math.random() * 10) + 3; // 3-12 seconds
-            
-            const process = {
-                id: processes.length + 1,
-                name: `${name} (${processType.name})`,
-                type: processType.name,
-                priority: priority,
-                cpuNeed: cpuNeed,
-                memoryNeed: memoryNeed,
-                ioNeed: ioNeed,
-                cpuAllocated: 0,
-                memoryAllocated: 0,
-                ioAllocated: 0,
-                burstTime: burstTime,
-                remainingTime: burstTime,
-                status: "waiting",
-                waitTime: 0,
-                arrivalTime: simulationTime,
-                completionTime: null,
-                pageFaults: 0
-            };
+            // Replace satisfied request edges with assignment edges after a grant
+            assign(process) {
+                this.request(process);
+                if (process.requestMask === 0) return;
+                for (let k = 0; k < resourceClasses.length; k++) {
+                    if (this.holds(process, k) && this.processReaches(process, k)) {
+                        this.suspects.add(process);
+                    }
+                }
+            }
             
-            processes.push(process);
-            addLog(`Process ${process.id} (${process.name}) created with priority ${priority}`, "info");
-            updateTotalProcessesDisplay();
-        }
-        
-        // Add a custom process
-        function addCustomProcess() {
-            const processType = processTypes[Math.floor(Math.random() * processTypes.length)];
-            const name = "Custom Process " + (processes.length + 1);
-            const priority = Math.floor(Math.random() * 10) + 1;
-            const cpuNeed = Math.min(Math.floor(Math.random() * resources.cpu) + 1, resources.cpu);
-            const memoryNeed = Math.min(Math.floor(Math.random() * 100) + 50, resources.memory);
-            const ioNeed = Math.min(Math.floor(Math.random() * resources.io) + 1, resources.io);
-            const burstTime = Math.floor(Math.random() * 8) + 2;
+            // Drop every edge touching the process
+            release(process) {
+                process.requestMask = 0;
+                this.untrack(process);
+                this.suspects.delete(process);
+            }
             
-            const process = {
-                id: processes.length + 1,
-                name: `${name} (${processType.name})`,
-                type: processType.name,
-                priority: priority,
-                cpuNeed: cpuNeed,
-                memoryNeed: memoryNeed,
-                ioNeed: ioNeed,
-                cpuAllocated: 0,
-                memoryAllocated: 0,
-                ioAllocated: 0,
-                burstTime: burstTime,
-                remainingTime: burstTime,
-                status: "waiting",
-                waitTime: 0,
-                arrivalTime: simulationTime,
-                completionTime: null,
-                pageFaults: 0
-            };
+            track(process) {
+                if (process.requestMask === 0 || !this.holdsAny(process)) {
+                    this.untrack(process);
+                    return;
+                }
+                this.blockedHolders.add(process);
+                for (let k = 0; k < resourceClasses.length; k++) {
+                    if (this.holds(process, k)) {
+                        this.holdersOf[k].add(process);
+                    } else {
+                        this.holdersOf[k].delete(process);
+                    }
+                }
+            }
             
-            processes.push(process);
-            addLog(`Custom process ${process.id} added to the system`, "info");
-            updateProcessList();
-            updateAllocationTable();
-            updateTotalProcessesDisplay();
-        }
-        
-        // Terminate a process
-        function terminateProcess(processId) {
-            const processIndex = processes.findIndex(p => p.id === processId);
-            if (processIndex !== -1) {
-                const process = processes[processIndex];
-                
-                // Free resources
-                resources.allocatedCPU -= process.cpuAllocated;
-                resources.allocatedMemory -= process.memoryAllocated;
-                resources.allocatedIO -= process.ioAllocated;
-                
-                process.status = "terminated";
-                process.completionTime = simulationTime;
-                
-                addLog(`Process ${processId} terminated manually`, "warning");
-                updateProcessList();
-                updateResourceList();
-                updateAllocationTable();
-                updateProcessStatusCounts();
+            untrack(process) {
+                if (!this.blockedHolders.delete(process)) return;
+                this.holdersOf.forEach(holders => holders.delete(process));
             }
-        }
-        
-        // ==============================
-        // RESOURCE ALLOCATION ALGORITHMS
-        // ==============================
-        
-        // Adaptive resource allocation algorithm
-        function allocateResourcesAdaptive() {
-            // Free resources from completed/terminated processes
-            processes.forEach(process => {
-                if (process.status === "completed" || process.status === "terminated") {
-                    resources.allocatedCPU -= process.cpuAllocated;
-                    resources.allocatedMemory -= process.memoryAllocated;
-                    resources.allocatedIO -= process.ioAllocated;
-                    
-                    process.cpuAllocated = 0;
-                    process.memoryAllocated = 0;
-                    process.ioAllocated = 0;
+            
+            // Does class `k` reach `target` through assignment/request edges?
+            classReaches(k, target) {
+                if (this.blockedHolders.size === 0) return false;
+                let seen = 1 << k;
+                const stack = [k];
+                while (stack.length > 0) {
+                    const current = stack.pop();
+                    for (const holder of this.holdersOf[current]) {
+                        if (holder === target) return true;
+                        for (let next = 0; next < resourceClasses.length; next++) {
+                            if ((holder.requestMask & (1 << next)) && !(seen & (1 << next))) {
+                                seen |= 1 << next;
+                                stack.push(next);
+                            }
+                        }
+                    }
                 }
-            });
+                return false;
+            }
             
-            const waitingProcesses = processes.filter(p => p.status === "waiting");
+            // Does `process` reach class `k` through its request edges?
+            processReaches(process, k) {
+                for (let next = 0; next < resourceClasses.length; next++) {
+                    if (!(process.requestMask & (1 << next))) continue;
+                    if (next === k || this.classReaches(next, process)) return true;
+                }
+                return false;
+            }
             
-            // Adaptive algorithm: consider priority, resource needs, and wait time
-            waitingProcesses.sort((a, b) => {
-                // Higher priority first
-                if (b.priority !== a.priority) return b.priority - a.priority;
-                
-                // If same priority, consider wait time (longer waiting processes get priority)
-                if (b.waitTime !== a.waitTime) return b.waitTime - a.waitTime;
-                
-                // If same wait time, consider resource needs (smaller needs first)
-                return (a.cpuNeed + a.memoryNeed/100 + a.ioNeed) - (b.cpuNeed + b.memoryNeed/100 + b.ioNeed);
-            });
+            // Resources that become free once every holder with nothing left
+            // to request finishes, minus what the blocked holders keep
+            workAfterSatisfiedHolders() {
+                const work = resourceClasses.map(cls => this.resources[cls.total]);
+                this.blockedHolders.forEach(holder => {
+                    for (let k = 0; k < resourceClasses.length; k++) {
+                        work[k] -= holder[resourceClasses[k].allocated];
+                    }
+                });
+                return work;
+            }
             
-            // Try to allocate resources to waiting processes
-            waitingProcesses.forEach(process => {
-                const cpuAvailable = resources.cpu - resources.allocatedCPU;
-                const memoryAvailable = resources.memory - resources.allocatedMemory;
-                const ioAvailable = resources.io - resources.allocatedIO;
-                
-                if (process.cpuNeed <= cpuAvailable && 
-                    process.memoryNeed <= memoryAvailable && 
-                    process.ioNeed <= ioAvailable) {
-                    
-                    // Allocate resources
-                    process.cpuAllocated = process.cpuNeed;
-                    process.memoryAllocated = process.memoryNeed;
-                    process.ioAllocated = process.ioNeed;
-                    process.status = "running";
-                    
-                    // Update system resource allocation
-                    resources.allocatedCPU += process.cpuNeed;
-                    resources.allocatedMemory += process.memoryNeed;
-                    resources.allocatedIO += process.ioNeed;
-                    
-                    contextSwitches++;
-                    addLog(`Process ${process.id} allocated resources (CPU: ${process.cpuNeed}, Memory: ${process.memoryNeed}MB, I/O: ${process.ioNeed})`, "success");
-                } else {
-                    // Process continues waiting
-                    process.waitTime += 1;
-                    totalWaitTime += 1;
-                }
-            });
-        }
-        
-        // Round Robin allocation
-        function allocateResourcesRoundRobin() {
-            // Free resources first
-            processes.forEach(process => {
-                if (process.status === "completed" || process.status === "terminated") {
-                    resources.allocatedCPU -= process.cpuAllocated;
-                    resources.allocatedMemory -= process.memoryAllocated;
-                    resources.allocatedIO -= process.ioAllocated;
-                    
-                    process.cpuAllocated = 0;
-                    process.memoryAllocated = 0;
-                    process.ioAllocated = 0;
+            // Reduce the blocked holders against `work`; returns the ones left over
+            reduce(work) {
+                let remaining = Array.from(this.blockedHolders);
+                let progress = true;
+                while (progress && remaining.length > 0) {
+                    progress = false;
+                    remaining = remaining.filter(holder => {
+                        for (let k = 0; k < resourceClasses.length; k++) {
+                            if (this.outstanding(holder, k) > work[k]) return true;
+                        }
+                        for (let k = 0; k < resourceClasses.length; k++) {
+                            work[k] += holder[resourceClasses[k].allocated];
+                        }
+                        progress = true;
+                        return false;
+                    });
                 }
-            });
+                return remaining;
+            }
             
-            const waitingProcesses = processes.filter(p => p.status === "waiting");
+            // Multi-instance resources: a cycle is necessary but not sufficient,
+            // so confirm it by graph reduction. Returns the deadlocked processes.
+            detect() {
+                if (this.suspects.size === 0) return [];
+                const deadlocked = this.reduce(this.workAfterSatisfiedHolders());
+                if (deadlocked.length === 0) this.suspects.clear();
+                return deadlocked;
+            }
             
-            // Simple round robin: allocate to first process that fits
-            for (let process of waitingProcesses) {
-                const cpuAvailable = resources.cpu - resources.allocatedCPU;
-                const memoryAvailable = resources.memory - resources.allocatedMemory;
-                const ioAvailable = resources.io - resources.allocatedIO;
-                
-                if (process.cpuNeed <= cpuAvailable && 
-                    process.memoryNeed <= memoryAvailable && 
-                    process.ioNeed <= ioAvailable) {
-                    
-                    process.cpuAllocated = process.cpuNeed;
-                    process.memoryAllocated = process.memoryNeed;
-                    process.ioAllocated = process.ioNeed;
-                    process.status = "running";
-                    
-                    resources.allocatedCPU += process.cpuNeed;
-                    resources.allocatedMemory += process.memoryNeed;
-                    resources.allocatedIO += process.ioNeed;
-                    
-                    contextSwitches++;
-                    addLog(`Process ${process.id} allocated resources (Round Robin)`, "success");
-                    break; // Only allocate to one process per cycle in RR
-                } else {
-                    process.waitTime += 1;
-                    totalWaitTime += 1;
+            // Banker's safety check for granting `process` its full request.
+            // The grantee is satisfied by the grant and will finish, so only
+            // the blocked holders decide whether a safe completion order exists.
+            isSafeGrant(process) {
+                if (this.blockedHolders.size === 0) return true;
+                const work = this.workAfterSatisfiedHolders();
+                if (this.blockedHolders.has(process)) {
+                    for (let k = 0; k < resourceClasses.length; k++) {
+                        work[k] += process[resourceClasses[k].allocated];
+                    }
                 }
+                return this.reduce(work).every(holder => holder === process);
             }
         }
         
-        // Priority-based allocation
-        function allocateResourcesPriority() {
-            // Free resources first
-            processes.forEach(process => {
-                if (process.status === "completed" || process.status === "terminated") {
-                    resources.allocatedCPU -= process.cpuAllocated;
-                    resources.allocatedMemory -= process.memoryAllocated;
-                    resources.allocatedIO -= process.ioAllocated;
-                    
-                    process.cpuAllocated = 0;
-                    process.memoryAllocated = 0;
-                    process.ioAllocated = 0;
-                }
-            });
+        // ==============================
+        // SCHEDULER CORE
+        // ==============================
+        
+        // Binary heap that stores each entry's slot in `heapIndex`, so a
+        // process can be removed from the middle of the queue in O(log n)
+        class IndexedHeap {
+            constructor(compare) {
+                this.compare = compare;
+                this.items = [];
+            }
             
-            const waitingProcesses = processes.filter(p => p.status === "waiting");
+            get size() {
+                return this.items.length;
+            }
+            
+            push(item) {
+                this.items.push(item);
+                item.heapIndex = this.items.length - 1;
+                this.siftUp(item.heapIndex);
+            }
             
-            // Sort by priority (higher priority first)
-            waitingProcesses.sort((a, b) => b.priority - a.priority);
+            pop() {
+                const top = this.items[0];
+                if (top !== undefined) this.remove(top);
+                return top;
+            }
             
-            // Allocate to highest priority processes that fit
-            waitingProcesses.forEach(process => {
-                const cpuAvailable = resources.cpu - resources.allocatedCPU;
-                const memoryAvailable = resources.memory - resources.allocatedMemory;
-                const ioAvailable = resources.io - resources.allocatedIO;
+            remove(item) {
+                const index = item.heapIndex;
+                if (index === undefined || index < 0) return;
                 
-                if (process.cpuNeed <= cpuAvailable && 
-                    process.memoryNeed <= memoryAvailable && 
-                    process.ioNeed <= ioAvailable) {
-                    
-                    process.cpuAllocated = process.cpuNeed;
-                    process.memoryAllocated = process.memoryNeed;
-                    process.ioAllocated = process.ioNeed;
-                    process.status = "running";
-                    
-                    resources.allocatedCPU += process.cpuNeed;
-                    resources.allocatedMemory += process.memoryNeed;
-                    resources.allocatedIO += process.ioNeed;
-                    
-                    contextSwitches++;
-                    addLog(`Process ${process.id} allocated resources (Priority)`, "success");
-                } else {
-                    process.waitTime += 1;
-                    totalWaitTime += 1;
+                const last = this.items.pop();
+                item.heapIndex = -1;
+                if (last !== item) {
+                    this.place(last, index);
+                    this.siftDown(index);
+                    this.siftUp(last.heapIndex);
                 }
-            });
-        }
-        
-        // First Come First Serve allocation
-        function allocateResourcesFCFS() {
-            // Free resources first
-            processes.forEach(process => {
-                if (process.status === "completed" || process.status === "terminated") {
-                    resources.allocatedCPU -= process.cpuAllocated;
-                    resources.allocatedMemory -= process.memoryAllocated;
-                    resources.allocatedIO -= process.ioAllocated;
-                    
-                    process.cpuAllocated = 0;
-                    process.memoryAllocated = 0;
-                    process.ioAllocated = 0;
+            }
+            
+            clear() {
+                this.items.forEach(item => { item.heapIndex = -1; });
+                this.items = [];
+            }
+            
+            // Re-heapify in O(n), used when the scheduling policy changes
+            rebuild(items, compare) {
+                this.clear();
+                this.compare = compare;
+                this.items = items.slice();
+                this.items.forEach((item, index) => { item.heapIndex = index; });
+                for (let i = (this.items.length >> 1) - 1; i >= 0; i--) {
+                    this.siftDown(i);
                 }
-            });
+            }
             
-            const waitingProcesses = processes.filter(p => p.status === "waiting");
+            place(item, index) {
+                this.items[index] = item;
+                item.heapIndex = index;
+            }
             
-            // Sort by arrival time
-            waitingProcesses.sort((a, b) => a.arrivalTime - b.arrivalTime);
+            siftUp(index) {
+                const item = this.items[index];
+                while (index > 0) {
+                    const parentIndex = (index - 1) >> 1;
+                    const parent = this.items[parentIndex];
+                    if (this.compare(item, parent) >= 0) break;
+                    this.place(parent, index);
+                    index = parentIndex;
+                }
+                this.place(item, index);
+            }
             
-            // Allocate to processes in order of arrival
-            waitingProcesses.forEach(process => {
-                const cpuAvailable = resources.cpu - resources.allocatedCPU;
-                const memoryAvailable = resources.memory - resources.allocatedMemory;
-                const ioAvailable = resources.io - resources.allocatedIO;
-                
-                if (process.cpuNeed <= cpuAvailable && 
-                    process.memoryNeed <= memoryAvailable && 
-                    process.ioNeed <= ioAvailable) {
-                    
-                    process.cpuAllocated = process.cpuNeed;
-                    process.memoryAllocated = process.memoryNeed;
-                    process.ioAllocated = process.ioNeed;
-                    process.status = "running";
-                    
-                    resources.allocatedCPU += process.cpuNeed;
-                    resources.allocatedMemory += process.memoryNeed;
-                    resources.allocatedIO += process.ioNeed;
-                    
-                    contextSwitches++;
-                    addLog(`Process ${process.id} allocated resources (FCFS)`, "success");
-                } else {
-                    process.waitTime += 1;
-                    totalWaitTime += 1;
+            siftDown(index) {
+                const items = this.items;
+                const item = items[index];
+                const half = items.length >> 1;
+                while (index < half) {
+                    let child = 2 * index + 1;
+                    if (child + 1 < items.length && this.compare(items[child + 1], items[child]) < 0) child++;
+                    if (this.compare(items[child], item) >= 0) break;
+                    this.place(items[child], index);
+                    index = child;
                 }
-            });
+                this.place(item, index);
+            }
         }
         
-        // Main allocation function that calls the appropriate algorithm
-        function allocateResources() {
-            const algorithm = algorithmSelect.value;
-            
-            switch(algorithm) {
-                case 'adaptive':
-                    allocateResourcesAdaptive();
-                    break;
-                case 'roundrobin':
-                    allocateResourcesRoundRobin();
-                    break;
-                case 'priority':
-                    allocateResourcesPriority();
-                    break;
-                case 'fcfs':
-                    allocateResourcesFCFS();
-                    break;
-                default:
-                    allocateResourcesAdaptive();
+        // Arrival-ordered FIFO. Processes leave the waiting state from anywhere
+        // in the queue, so departed entries are skipped lazily and compacted
+        // once they outnumber the live ones.
+        class ArrivalQueue {
+            constructor() {
+                this.items = [];
+                this.head = 0;
+                this.dead = 0;
             }
             
-            // Update process status counts
-            updateProcessStatusCounts();
+            push(process) {
+                this.items.push(process);
+            }
             
-            // Check for deadlocks if enabled
-            if (deadlockDetectionSelect.value === 'on') {
-                checkForDeadlocks();
+            remove() {
+                this.dead++;
             }
-        }
-        
-        // ==============================
-        // DEADLOCK DETECTION
-        // ==============================
-        
-        function checkForDeadlocks() {
-            const waitingProcesses = processes.filter(p => p.status === "waiting");
-            let deadlockDetected = false;
             
-            // Simple deadlock detection: if a process has been waiting too long
-            waitingProcesses.forEach(process => {
-                if (process.waitTime > 10) { // Threshold for deadlock detection
-                    deadlockDetected = true;
-                    addLog(`Warning: Process ${process.id} has been waiting for ${process.waitTime}s - possible deadlock`, "warning");
+            // Visit waiting processes oldest first; stop when `visit` returns false.
+            // `visit` may remove processes, so compaction only happens up front.
+            scan(visit) {
+                if (this.dead > 32 && this.dead > this.items.length - this.head - this.dead) {
+                    this.items = this.items.filter((process, index) => index >= this.head && process.status === "waiting");
+                    this.head = 0;
+                    this.dead = 0;
                 }
-            });
-            
-            // If deadlock detected and no processes are running
-            if (deadlockDetected && processStatusCounts.running === 0 && waitingProcesses.length > 0) {
-                deadlockCount++;
-                deadlockWarningElement.style.display = 'block';
-                addLog(`DEADLOCK DETECTED! ${waitingProcesses.length} processes are blocked`, "error");
-                
-                // Automatically terminate the lowest priority process to break deadlock
-                if (waitingProcesses.length > 0) {
-                    waitingProcesses.sort((a, b) => a.priority - b.priority); // Lowest priority first
-                    terminateProcess(waitingProcesses[0].id);
-                    addLog(`Process ${waitingProcesses[0].id} terminated to break deadlock`, "error");
+                while (this.head < this.items.length && this.items[this.head].status !== "waiting") {
+                    this.head++;
+                    this.dead--;
+                }
+                for (let i = this.head; i < this.items.length; i++) {
+                    const process = this.items[i];
+                    if (process.status === "waiting" && visit(process) === false) return;
                 }
-            } else {
-                deadlockWarningElement.style.display = 'none';
             }
             
-            updateStats();
+            toArray() {
+                const waiting = [];
+                this.scan(process => { waiting.push(process); });
+                return waiting;
+            }
         }
         
-        // ==============================
-        // PROCESS EXECUTION
-        // ==============================
+        // Ordering of the waiting queue for each allocation algorithm. Every
+        // waiting process ages at the same rate, so "longer wait" is simply
+        // "earlier waitingSince" and heap keys never change while queued.
+        // `seq` (admission order) breaks the remaining ties like a stable sort.
+        const schedulingPolicies = {
+            adaptive: {
+                queue: "heap",
+                grantLimit: Infinity,
+                compare: (a, b) =>
+                    // Higher priority first, then longer wait, then smaller needs
+                    (b.priority - a.priority) ||
+                    (a.waitingSince - b.waitingSince) ||
+                    ((a.cpuNeed + a.memoryNeed/100 + a.ioNeed) - (b.cpuNeed + b.memoryNeed/100 + b.ioNeed)) ||
+                    (a.seq - b.seq)
+            },
+            priority: {
+                queue: "heap",
+                grantLimit: Infinity,
+                compare: (a, b) => (b.priority - a.priority) || (a.seq - b.seq)
+            },
+            fcfs: {
+                queue: "fifo",
+                grantLimit: Infinity
+            },
+            roundrobin: {
+                queue: "fifo",
+                grantLimit: 1 // Only allocate to one process per cycle in RR
+            },
+            backfill: {
+                queue: "fifo",
+                grantLimit: Infinity,
+                backfill: true
+            }
+        };
         
-        function executeProcesses() {
-            processes.forEach(process => {
-                if (process.status === "running") {
-                    process.remainingTime -= 1;
-                    
-                    // Simulate page faults for memory-intensive processes
-                    if (process.type === "Memory Intensive" && Math.random() < 0.1) {
-                        process.pageFaults++;
-                        pageFaults++;
-                        addLog(`Page fault occurred in Process ${process.id}`, "warning");
+        // How many waiters behind a blocked head one backfill pass considers
+        const BACKFILL_DEPTH = 256;
+        
+        // Arrivals are sorted on their own only while they are under
+        // 1/FRESH_SORT_FRACTION of the heap; otherwise the heap is rescanned
+        const FRESH_SORT_FRACTION = 8;
+        
+        // Starvation warnings logged individually per tick before the rest
+        // are reported as a single count
+        const STARVATION_WARNINGS_PER_TICK = 20;
+        
+        // Shared state machine behind all allocation algorithms. Processes move
+        // between the waiting queues and the running set only on state
+        // transitions, and status counts and wait totals are kept incrementally,
+        // so a tick costs O(state changes) rather than O(total processes).
+        class SchedulerCore {
+            constructor(resources, clock) {
+                this.resources = resources;
+                this.clock = clock;
+                this.policyName = "adaptive";
+                this.policy = schedulingPolicies.adaptive;
+                this.heap = new IndexedHeap(this.policy.compare);
+                this.fifo = new ArrivalQueue();
+                this.running = new Set();
+                this.byId = new Map();
+                this.counts = { running: 0, waiting: 0, completed: 0, terminated: 0 };
+                this.nextSeq = 0;
+                
+                // Smallest needs ever admitted: a lower bound on what any waiting
+                // process asks for, so a pass can stop once less than this is free
+                this.minNeed = { cpu: Infinity, memory: Infinity, io: Infinity };
+                
+                // Wait time is aged lazily: a waiting process has waited
+                // `now - waitingSince` on top of what it had already banked
+                this.waitingSinceSum = 0;
+                this.bankedWaitTime = 0;
+                
+                // Processes admitted since the last allocation pass; if nothing
+                // was freed in between, only these can possibly fit now
+                this.fresh = [];
+                this.needsRescan = false;
+                
+                // Claims graph for deadlock detection, an optional veto on grants
+                // (Banker's avoidance) and why grants were held back
+                this.graph = new ResourceAllocationGraph(resources);
+                this.grantGuard = null;
+                this.deferred = { cpu: 0, memory: 0, io: 0, unsafe: 0, reservation: 0 };
+                
+                // When a Set, every process whose state changes is added to it
+                // (the owner clears it); used to publish per-tick deltas
+                this.changed = null;
+                
+                // Start time promised to the blocked head of the queue when backfilling
+                this.reservation = null;
+            }
+            
+            setPolicy(name) {
+                const policy = schedulingPolicies[name] || schedulingPolicies.adaptive;
+                if (policy === this.policy) return;
+                
+                this.policy = policy;
+                this.policyName = name;
+                if (policy.queue === "heap") {
+                    this.heap.rebuild(this.fifo.toArray(), policy.compare);
+                } else {
+                    this.heap.clear();
+                }
+                this.reservation = null;
+                this.needsRescan = true;
+            }
+            
+            admit(process) {
+                const now = this.clock();
+                process.seq = this.nextSeq++;
+                process.status = "waiting";
+                process.waitingSince = now;
+                process.heapIndex = -1;
+                
+                this.byId.set(process.id, process);
+                this.fifo.push(process);
+                if (this.policy.queue === "heap") this.heap.push(process);
+                this.fresh.push(process);
+                this.counts.waiting++;
+                this.minNeed.cpu = Math.min(this.minNeed.cpu, process.cpuNeed);
+                this.minNeed.memory = Math.min(this.minNeed.memory, process.memoryNeed);
+                this.minNeed.io = Math.min(this.minNeed.io, process.ioNeed);
+                this.graph.request(process);
+                this.waitingSinceSum += now;
+                if (this.changed !== null) this.changed.add(process);
+            }
+            
+            get(processId) {
+                return this.byId.get(processId);
+            }
+            
+            waitTimeOf(process) {
+                return process.status === "waiting" ?
+                    process.waitTime + (this.clock() - process.waitingSince) :
+                    process.waitTime;
+            }
+            
+            totalWaitTime() {
+                return this.bankedWaitTime + this.counts.waiting * this.clock() - this.waitingSinceSum;
+            }
+            
+            // The first resource `process` needs more of than is free, or null
+            shortfall(process) {
+                const r = this.resources;
+                if (process.cpuNeed > r.cpu - r.allocatedCPU) return "cpu";
+                if (process.memoryNeed > r.memory - r.allocatedMemory) return "memory";
+                if (process.ioNeed > r.io - r.allocatedIO) return "io";
+                return null;
+            }
+            
+            // Why `process` cannot be granted right now, or null if it can
+            deferReason(process) {
+                const reason = this.shortfall(process);
+                if (reason !== null) return reason;
+                if (this.grantGuard !== null && !this.grantGuard(process)) return "unsafe";
+                return null;
+            }
+            
+            exhausted() {
+                const r = this.resources;
+                return r.cpu - r.allocatedCPU < this.minNeed.cpu ||
+                    r.memory - r.allocatedMemory < this.minNeed.memory ||
+                    r.io - r.allocatedIO < this.minNeed.io;
+            }
+            
+            // Run one allocation pass with the given algorithm, calling `onGrant`
+            // for each process that receives its resources
+            allocate(policyName, onGrant) {
+                this.setPolicy(policyName);
+                if (this.policy.backfill) {
+                    this.backfill(onGrant);
+                    return;
+                }
+                
+                const limit = this.policy.grantLimit;
+                let granted = 0;
+                const tryGrant = process => {
+                    if (this.exhausted()) return false;
+                    const reason = this.deferReason(process);
+                    if (reason !== null) {
+                        this.deferred[reason]++;
+                        return true;
+                    }
+                    this.grant(process);
+                    onGrant(process);
+                    return ++granted < limit;
+                };
+                
+                // Sorting a batch of arrivals that is a large part of the queue
+                // costs more than popping the heap, which already keeps it in order
+                if (this.policy.queue === "heap" && this.fresh.length * FRESH_SORT_FRACTION > this.heap.size) {
+                    this.needsRescan = true;
+                }
+                
+                if (this.needsRescan) {
+                    if (this.policy.queue === "heap") {
+                        const skipped = [];
+                        while (this.heap.size > 0) {
+                            const process = this.heap.pop();
+                            skipped.push(process);
+                            if (tryGrant(process) === false) break;
+                        }
+                        skipped.forEach(process => {
+                            if (process.status === "waiting") this.heap.push(process);
+                        });
+                    } else {
+                        this.fifo.scan(tryGrant);
+                    }
+                } else if (this.fresh.length > 0) {
+                    // Nothing was freed, so older waiters still cannot fit
+                    const candidates = this.policy.queue === "heap" ?
+                        this.fresh.slice().sort(this.policy.compare) : this.fresh;
+                    for (const process of candidates) {
+                        if (process.status === "waiting" && tryGrant(process) === false) break;
+                    }
+                }
+                
+                // A pass cut short by the grant limit must resume next tick
+                this.needsRescan = granted >= limit && this.counts.waiting > 0;
+                this.fresh = [];
+            }
+            
+            // EASY backfilling: grant in arrival order until the head of the
+            // queue does not fit, reserve the earliest tick it will, then let
+            // later arrivals run ahead only if they leave that start intact
+            backfill(onGrant) {
+                const now = this.clock();
+                let reservation = this.reservation;
+                let candidates;
+                
+                if (this.needsRescan || reservation === null || reservation.process.status !== "waiting") {
+                    reservation = null;
+                    candidates = [];
+                    this.fifo.scan(process => {
+                        if (reservation === null) {
+                            const reason = this.deferReason(process);
+                            if (reason === null) {
+                                this.grant(process);
+                                onGrant(process);
+                                return true;
+                            }
+                            this.deferred[reason]++;
+                            reservation = this.reserve(process, now);
+                            return true;
+                        }
+                        if (this.exhausted()) return false;
+                        candidates.push(process);
+                        return candidates.length < BACKFILL_DEPTH;
+                    });
+                } else {
+                    // Nothing was freed, so the head still waits for the same tick
+                    candidates = this.fresh.filter(process => process.status === "waiting");
+                }
+                
+                if (reservation !== null && candidates.length > 0) {
+                    this.pack(candidates, reservation, now, onGrant);
+                }
+                this.reservation = reservation;
+                this.needsRescan = false;
+                this.fresh = [];
+            }
+            
+            // When `process` can start given the running processes' remaining
+            // times, and what will still be free once it does (`spare`)
+            reserve(process, now) {
+                const r = this.resources;
+                const free = {
+                    cpu: r.cpu - r.allocatedCPU,
+                    memory: r.memory - r.allocatedMemory,
+                    io: r.io - r.allocatedIO
+                };
+                const fits = () =>
+                    process.cpuNeed <= free.cpu && process.memoryNeed <= free.memory && process.ioNeed <= free.io;
+                
+                let at = now;
+                if (!fits()) {
+                    const finishing = Array.from(this.running).sort((a, b) => a.remainingTime - b.remainingTime);
+                    for (let i = 0; i < finishing.length; i++) {
+                        const running = finishing[i];
+                        free.cpu += running.cpuAllocated;
+                        free.memory += running.memoryAllocated;
+                        free.io += running.ioAllocated;
+                        at = now + running.remainingTime;
+                        const next = finishing[i + 1];
+                        if (fits() && (next === undefined || next.remainingTime !== running.remainingTime)) break;
+                    }
+                }
+                
+                return {
+                    process: process,
+                    at: at,
+                    spare: {
+                        cpu: free.cpu - process.cpuNeed,
+                        memory: free.memory - process.memoryNeed,
+                        io: free.io - process.ioNeed
+                    }
+                };
+            }
+            
+            // Vector bin-packing over the backfill candidates: repeatedly grant
+            // the one whose needs best align with what is free (dot product of
+            // the capacity-normalised vectors). A candidate must finish by the
+            // reserved tick or fit in the reservation's spare resources.
+            pack(candidates, reservation, now, onGrant) {
+                const r = this.resources;
+                const spare = reservation.spare;
+                const delaysHead = process =>
+                    now + process.burstTime > reservation.at &&
+                    (process.cpuNeed > spare.cpu || process.memoryNeed > spare.memory || process.ioNeed > spare.io);
+                
+                while (candidates.length > 0 && !this.exhausted()) {
+                    const freeCPU = (r.cpu - r.allocatedCPU) / r.cpu;
+                    const freeMemory = (r.memory - r.allocatedMemory) / r.memory;
+                    const freeIO = (r.io - r.allocatedIO) / r.io;
+                    
+                    let best = -1;
+                    let bestScore = -Infinity;
+                    for (let i = 0; i < candidates.length; i++) {
+                        const process = candidates[i];
+                        if (this.shortfall(process) !== null || delaysHead(process)) continue;
+                        const score = process.cpuNeed / r.cpu * freeCPU +
+                            process.memoryNeed / r.memory * freeMemory +
+                            process.ioNeed / r.io * freeIO;
+                        if (score > bestScore) {
+                            best = i;
+                            bestScore = score;
+                        }
+                    }
+                    if (best < 0) break;
+                    
+                    const process = candidates.splice(best, 1)[0];
+                    if (this.grantGuard !== null && !this.grantGuard(process)) {
+                        this.deferred.unsafe++;
+                        continue;
+                    }
+                    if (now + process.burstTime > reservation.at) {
+                        spare.cpu -= process.cpuNeed;
+                        spare.memory -= process.memoryNeed;
+                        spare.io -= process.ioNeed;
+                    }
+                    this.grant(process);
+                    onGrant(process);
+                }
+                
+                candidates.forEach(process => {
+                    this.deferred[this.shortfall(process) || "reservation"]++;
+                });
+            }
+            
+            leaveWaiting(process) {
+                const now = this.clock();
+                const waited = now - process.waitingSince;
+                process.waitTime += waited;
+                this.bankedWaitTime += waited;
+                this.waitingSinceSum -= process.waitingSince;
+                this.counts.waiting--;
+                this.heap.remove(process);
+                this.fifo.remove(process);
+                this.graph.release(process);
+            }
+            
+            grant(process) {
+                this.leaveWaiting(process);
+                
+                process.cpuAllocated = process.cpuNeed;
+                process.memoryAllocated = process.memoryNeed;
+                process.ioAllocated = process.ioNeed;
+                process.status = "running";
+                
+                this.resources.allocatedCPU += process.cpuNeed;
+                this.resources.allocatedMemory += process.memoryNeed;
+                this.resources.allocatedIO += process.ioNeed;
+                this.graph.assign(process);
+                
+                this.running.add(process);
+                this.counts.running++;
+                if (this.changed !== null) this.changed.add(process);
+            }
+            
+            // Return whatever the process holds to the pool
+            freeResources(process) {
+                this.graph.release(process);
+                this.resources.allocatedCPU -= process.cpuAllocated;
+                this.resources.allocatedMemory -= process.memoryAllocated;
+                this.resources.allocatedIO -= process.ioAllocated;
+                
+                process.cpuAllocated = 0;
+                process.memoryAllocated = 0;
+                process.ioAllocated = 0;
+                this.needsRescan = true;
+                if (this.changed !== null) this.changed.add(process);
+            }
+            
+            release(process) {
+                this.freeResources(process);
+                this.running.delete(process);
+                this.counts.running--;
+            }
+            
+            complete(process) {
+                this.release(process);
+                process.status = "completed";
+                process.completionTime = this.clock();
+                this.counts.completed++;
+            }
+            
+            terminate(process) {
+                if (process.status === "waiting") {
+                    this.leaveWaiting(process);
+                    if (this.graph.holdsAny(process)) this.freeResources(process);
+                } else if (process.status === "running") {
+                    this.release(process);
+                } else {
+                    return false;
+                }
+                process.status = "terminated";
+                process.completionTime = this.clock();
+                this.counts.terminated++;
+                if (this.changed !== null) this.changed.add(process);
+                return true;
+            }
+            
+            // Visit waiting processes in arrival order (longest wait first);
+            // stop when `visit` returns false
+            forEachWaiting(visit) {
+                this.fifo.scan(visit);
+            }
+        }
+        
+        // ==============================
+        // TRACING AND PROFILING
+        // ==============================
+        
+        // Binary trace of one or more runs, little-endian, one record per
+        // event: a kind byte, then the fields listed below. The inputs (seed,
+        // arrivals, steps with their algorithm and deadlock mode, manual
+        // terminations) are enough to re-execute a run; the outcomes (grants,
+        // completions, deadlock victims) let a replay check it did the same.
+        const TRACE_MAGIC = 0x41435254; // "TRCA"
+        const TRACE_VERSION = 1;
+        const traceKinds = {
+            header: 1,          // u32 magic, u8 version, u32 seed, i32 cpu, i32 memory, i32 io
+            mode: 2,            // u8 algorithm, u8 deadlock mode; written when either changes
+            mix: 3,             // u8 count, f64 weights; written when the arrival mix changes
+            randomArrival: 4,   // u32 id; the process is regenerated from the seed
+            arrival: 5,         // u32 id, u8 type, u8 priority, i32 cpu, i32 memory, i32 io, i32 burst, u16 length, UTF-8 name
+            step: 6,
+            terminate: 7,       // u32 id, manual termination
+            grant: 8,           // u32 id
+            complete: 9,        // u32 id
+            kill: 10,           // u32 id, deadlock victim
+            end: 11             // u32 time
+        };
+        const traceKindNames = [];
+        Object.keys(traceKinds).forEach(name => { traceKindNames[traceKinds[name]] = name; });
+        const traceAlgorithms = ["adaptive", "roundrobin", "priority", "fcfs", "backfill"];
+        const traceDeadlockModes = ["on", "avoid", "off"];
+        const TRACE_NAME_LIMIT = 1024;
+        
+        // Encodes records into fixed-size chunks and hands each full chunk to
+        // `onChunk(bytes)`, so recording holds one chunk in memory however long
+        // the run is. end() or flush() hands over the partial last chunk.
+        class TraceWriter {
+            constructor(onChunk, chunkSize = 65536) {
+                this.onChunk = onChunk;
+                this.chunkSize = chunkSize;
+                this.encoder = new TextEncoder();
+                this.bytesWritten = 0;
+                this.startChunk();
+                this.resetModes();
+            }
+            
+            startChunk() {
+                this.bytes = new Uint8Array(this.chunkSize);
+                this.view = new DataView(this.bytes.buffer);
+                this.offset = 0;
+            }
+            
+            resetModes() {
+                this.algorithm = -1;
+                this.deadlockMode = -1;
+                this.typeWeights = null;
+            }
+            
+            flush() {
+                if (this.offset === 0) return;
+                this.bytesWritten += this.offset;
+                this.onChunk(this.bytes.subarray(0, this.offset));
+                this.startChunk();
+            }
+            
+            // Start a record of `size` bytes, kind byte included
+            record(kind, size) {
+                if (this.offset + size > this.chunkSize) this.flush();
+                this.u8(kind);
+            }
+            
+            u8(value) { this.view.setUint8(this.offset, value); this.offset += 1; }
+            u16(value) { this.view.setUint16(this.offset, value, true); this.offset += 2; }
+            u32(value) { this.view.setUint32(this.offset, value, true); this.offset += 4; }
+            i32(value) { this.view.setInt32(this.offset, value, true); this.offset += 4; }
+            f64(value) { this.view.setFloat64(this.offset, value, true); this.offset += 8; }
+            
+            id(kind, id) {
+                this.record(kind, 5);
+                this.u32(id);
+            }
+            
+            header(seed, resources) {
+                this.resetModes();
+                this.record(traceKinds.header, 22);
+                this.u32(TRACE_MAGIC);
+                this.u8(TRACE_VERSION);
+                this.u32(seed);
+                this.i32(resources.cpu);
+                this.i32(resources.memory);
+                this.i32(resources.io);
+            }
+            
+            randomArrival(id, typeWeights) {
+                const weights = typeWeights || null;
+                const same = weights === this.typeWeights || (weights !== null && this.typeWeights !== null &&
+                    weights.length === this.typeWeights.length && weights.every((weight, i) => weight === this.typeWeights[i]));
+                if (!same) {
+                    this.typeWeights = weights && weights.slice();
+                    const count = weights ? weights.length : 0;
+                    this.record(traceKinds.mix, 2 + 8 * count);
+                    this.u8(count);
+                    for (let i = 0; i < count; i++) this.f64(weights[i]);
+                }
+                this.id(traceKinds.randomArrival, id);
+            }
+            
+            arrival(id, spec) {
+                const name = this.encoder.encode(spec.name).subarray(0, TRACE_NAME_LIMIT);
+                const type = processTypes.findIndex(processType => processType.name === spec.type);
+                this.record(traceKinds.arrival, 25 + name.length);
+                this.u32(id);
+                this.u8(type < 0 ? 255 : type);
+                this.u8(spec.priority);
+                this.i32(spec.cpuNeed);
+                this.i32(spec.memoryNeed);
+                this.i32(spec.ioNeed);
+                this.i32(spec.burstTime);
+                this.u16(name.length);
+                this.bytes.set(name, this.offset);
+                this.offset += name.length;
+            }
+            
+            // Unknown algorithms run as adaptive and unknown deadlock modes as off
+            step(algorithm, deadlockMode) {
+                const algorithmCode = Math.max(traceAlgorithms.indexOf(algorithm), 0);
+                const modeCode = traceDeadlockModes.indexOf(deadlockMode) < 0 ? 2 : traceDeadlockModes.indexOf(deadlockMode);
+                if (algorithmCode !== this.algorithm || modeCode !== this.deadlockMode) {
+                    this.algorithm = algorithmCode;
+                    this.deadlockMode = modeCode;
+                    this.record(traceKinds.mode, 3);
+                    this.u8(algorithmCode);
+                    this.u8(modeCode);
+                }
+                this.record(traceKinds.step, 1);
+            }
+            
+            terminate(id) { this.id(traceKinds.terminate, id); }
+            grant(id) { this.id(traceKinds.grant, id); }
+            complete(id) { this.id(traceKinds.complete, id); }
+            kill(id) { this.id(traceKinds.kill, id); }
+            
+            end(time) {
+                this.id(traceKinds.end, time);
+                this.flush();
+            }
+        }
+        
+        // Decodes a trace fed in chunks of any size (records may straddle
+        // chunks) into plain records such as { kind: "grant", id: 3 }
+        class TraceReader {
+            constructor() {
+                this.pending = new Uint8Array(0);
+                this.decoder = new TextDecoder();
+            }
+            
+            push(chunk) {
+                let bytes = chunk;
+                if (this.pending.length > 0) {
+                    bytes = new Uint8Array(this.pending.length + chunk.length);
+                    bytes.set(this.pending);
+                    bytes.set(chunk, this.pending.length);
+                }
+                const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+                const records = [];
+                let offset = 0;
+                for (;;) {
+                    const size = this.sizeAt(view, offset);
+                    if (size === 0 || offset + size > bytes.length) break;
+                    records.push(this.decode(view, bytes, offset));
+                    offset += size;
+                }
+                this.pending = bytes.slice(offset);
+                return records;
+            }
+            
+            finish() {
+                if (this.pending.length > 0) throw new Error(`Trace ends inside a record (${this.pending.length} bytes left)`);
+            }
+            
+            // Size of the record at `offset`, or 0 if not enough of it is here to tell
+            sizeAt(view, offset) {
+                const available = view.byteLength - offset;
+                if (available < 1) return 0;
+                const kind = view.getUint8(offset);
+                switch (kind) {
+                    case traceKinds.header: return 22;
+                    case traceKinds.mode: return 3;
+                    case traceKinds.mix: return available < 2 ? 0 : 2 + 8 * view.getUint8(offset + 1);
+                    case traceKinds.arrival: return available < 25 ? 0 : 25 + view.getUint16(offset + 23, true);
+                    case traceKinds.step: return 1;
+                    case traceKinds.randomArrival:
+                    case traceKinds.terminate:
+                    case traceKinds.grant:
+                    case traceKinds.complete:
+                    case traceKinds.kill:
+                    case traceKinds.end:
+                        return 5;
+                    default:
+                        throw new Error(`Unknown trace record kind ${kind}`);
+                }
+            }
+            
+            decode(view, bytes, offset) {
+                const kind = traceKindNames[view.getUint8(offset)];
+                switch (kind) {
+                    case "header":
+                        if (view.getUint32(offset + 1, true) !== TRACE_MAGIC) throw new Error("Not an allocation trace");
+                        if (view.getUint8(offset + 5) !== TRACE_VERSION) throw new Error(`Unsupported trace version ${view.getUint8(offset + 5)}`);
+                        return {
+                            kind: kind,
+                            seed: view.getUint32(offset + 6, true),
+                            cpu: view.getInt32(offset + 10, true),
+                            memory: view.getInt32(offset + 14, true),
+                            io: view.getInt32(offset + 18, true)
+                        };
+                    case "mode":
+                        return {
+                            kind: kind,
+                            algorithm: traceAlgorithms[view.getUint8(offset + 1)],
+                            deadlockMode: traceDeadlockModes[view.getUint8(offset + 2)]
+                        };
+                    case "mix": {
+                        const weights = [];
+                        for (let i = 0; i < view.getUint8(offset + 1); i++) weights.push(view.getFloat64(offset + 2 + 8 * i, true));
+                        return { kind: kind, weights: weights.length > 0 ? weights : null };
+                    }
+                    case "arrival": {
+                        const type = processTypes[view.getUint8(offset + 5)];
+                        const nameLength = view.getUint16(offset + 23, true);
+                        return {
+                            kind: kind,
+                            id: view.getUint32(offset + 1, true),
+                            spec: {
+                                name: this.decoder.decode(bytes.subarray(offset + 25, offset + 25 + nameLength)),
+                                type: type ? type.name : "",
+                                priority: view.getUint8(offset + 6),
+                                cpuNeed: view.getInt32(offset + 7, true),
+                                memoryNeed: view.getInt32(offset + 11, true),
+                                ioNeed: view.getInt32(offset + 15, true),
+                                burstTime: view.getInt32(offset + 19, true)
+                            }
+                        };
+                    }
+                    case "step":
+                        return { kind: kind };
+                    case "end":
+                        return { kind: kind, time: view.getUint32(offset + 1, true) };
+                    default:
+                        return { kind: kind, id: view.getUint32(offset + 1, true) };
+                }
+            }
+        }
+        
+        // Re-executes trace records at full speed. Each header starts a fresh
+        // engine with the recorded seed and resources, inputs are applied in
+        // order and every recorded outcome is checked against what the engine
+        // does now. `firstDivergence` says where the two first disagreed.
+        class TraceReplay {
+            constructor(profiler) {
+                this.profiler = profiler || null;
+                this.engine = null;
+                this.runs = 0;
+                this.ticks = 0;
+                this.checked = 0;
+                this.divergences = 0;
+                this.firstDivergence = null;
+                
+                // Stands in for a TraceWriter on the replaying engine: keeps
+                // the outcomes in order and ignores the inputs
+                const outcomes = this.outcomes = [];
+                const keep = kind => id => { outcomes.push({ kind: kind, id: id }); };
+                this.recorder = {
+                    randomArrival() {}, arrival() {}, step() {}, terminate() {},
+                    grant: keep("grant"), complete: keep("complete"), kill: keep("kill")
+                };
+                this.nextOutcome = 0;
+            }
+            
+            apply(record) {
+                switch (record.kind) {
+                    case "header":
+                        this.settle();
+                        this.engine = new SimulationEngine({ cpu: record.cpu, memory: record.memory, io: record.io, seed: record.seed });
+                        this.engine.trace = this.recorder;
+                        this.engine.profiler = this.profiler;
+                        this.algorithm = traceAlgorithms[0];
+                        this.deadlockMode = traceDeadlockModes[0];
+                        this.typeWeights = null;
+                        this.runs++;
+                        break;
+                    case "mode":
+                        this.algorithm = record.algorithm;
+                        this.deadlockMode = record.deadlockMode;
+                        break;
+                    case "mix":
+                        this.typeWeights = record.weights;
+                        break;
+                    case "randomArrival":
+                        this.check(record, this.engine.addRandomProcess(this.typeWeights).id === record.id);
+                        break;
+                    case "arrival":
+                        this.check(record, this.engine.addProcess(record.spec).id === record.id);
+                        break;
+                    case "terminate":
+                        this.engine.terminateProcess(record.id);
+                        break;
+                    case "step":
+                        this.settle();
+                        this.engine.step(this.algorithm, this.deadlockMode);
+                        this.ticks++;
+                        break;
+                    case "end":
+                        this.settle();
+                        this.check(record, this.engine.time === record.time);
+                        break;
+                    default: {
+                        const outcome = this.outcomes[this.nextOutcome++];
+                        this.check(record, outcome !== undefined && outcome.kind === record.kind && outcome.id === record.id, outcome);
+                    }
+                }
+            }
+            
+            // Outcomes the engine produced that the trace did not record
+            settle() {
+                while (this.nextOutcome < this.outcomes.length) {
+                    this.check(null, false, this.outcomes[this.nextOutcome++]);
+                }
+                this.outcomes.length = 0;
+                this.nextOutcome = 0;
+            }
+            
+            check(expected, ok, actual) {
+                this.checked++;
+                if (ok) return;
+                this.divergences++;
+                if (this.firstDivergence === null) {
+                    this.firstDivergence = { time: this.engine ? this.engine.time : 0, expected: expected, actual: actual || null };
+                }
+            }
+        }
+        
+        // Accumulates self time per nested begin(name)/end() phase and exports
+        // it as folded stacks, the input format of flame graph tools: one
+        // "tick;allocate 1234" line per stack, in microseconds.
+        class PhaseProfiler {
+            constructor(now) {
+                this.now = now || (() => performance.now());
+                this.keys = [];
+                this.starts = [];
+                this.children = [];
+                this.depth = 0;
+                this.selfTime = new Map();
+            }
+            
+            begin(name) {
+                const depth = this.depth++;
+                this.keys[depth] = depth > 0 ? this.keys[depth - 1] + ";" + name : name;
+                this.children[depth] = 0;
+                this.starts[depth] = this.now();
+            }
+            
+            end() {
+                const depth = --this.depth;
+                const elapsed = this.now() - this.starts[depth];
+                const key = this.keys[depth];
+                this.selfTime.set(key, (this.selfTime.get(key) || 0) + elapsed - this.children[depth]);
+                if (depth > 0) this.children[depth - 1] += elapsed;
+            }
+            
+            clear() {
+                this.depth = 0;
+                this.selfTime.clear();
+            }
+            
+            // `root`, if given, is prepended to every stack
+            folded(root) {
+                const prefix = root ? root + ";" : "";
+                const lines = [];
+                this.selfTime.forEach((milliseconds, stack) => {
+                    const microseconds = Math.round(milliseconds * 1000);
+                    if (microseconds > 0) lines.push(`${prefix}${stack} ${microseconds}`);
+                });
+                return lines.join("\n");
+            }
+        }
+        
+        // Stands in when no profiler is attached
+        const idleProfiler = { begin() {}, end() {} };
+        
+        // ==============================
+        // SIMULATION ENGINE
+        // ==============================
+        
+        // One simulated system: resources, processes, scheduler and counters.
+        // `random` drives every random decision; pass `seed` instead for a
+        // reproducible run that can be traced. `log(message, type)`, `trace`
+        // (a TraceWriter, see startTrace) and `profiler` (a PhaseProfiler
+        // timing each step's phases) are optional.
+        class SimulationEngine {
+            constructor(options) {
+                this.seed = options.seed;
+                this.random = options.random || (options.seed !== undefined ? createRandom(options.seed) : Math.random);
+                this.log = options.log || null;
+                this.trace = null;
+                this.profiler = options.profiler || null;
+                this.starvationThreshold = options.starvationThreshold || 10;
+                this.starvationCursor = 0;
+                this.time = 0;
+                this.processes = [];
+                this.resources = {
+                    cpu: options.cpu,
+                    memory: options.memory,
+                    io: options.io,
+                    allocatedCPU: 0,
+                    allocatedMemory: 0,
+                    allocatedIO: 0
+                };
+                this.scheduler = new SchedulerCore(this.resources, () => this.time);
+                this.stats = {
+                    completed: 0,
+                    totalTurnaroundTime: 0,
+                    contextSwitches: 0,
+                    pageFaults: 0,
+                    deadlocks: 0,
+                    deferred: this.scheduler.deferred
+                };
+                this.bankersCheck = process => this.scheduler.graph.isSafeGrant(process);
+            }
+            
+            // Record this run from the start: the trace holds the seed and the
+            // inputs, not the random draws, so the engine must be seeded and new
+            startTrace(trace) {
+                if (this.seed === undefined) throw new Error("Tracing needs an engine created with a seed");
+                if (this.processes.length > 0 || this.time > 0) throw new Error("Tracing must start before the first process");
+                this.trace = trace;
+                trace.header(this.seed, this.resources);
+            }
+            
+            // Add a process described by name/type/priority/needs/burstTime
+            addProcess(spec) {
+                if (this.trace) this.trace.arrival(this.processes.length + 1, spec);
+                return this.admitProcess(spec);
+            }
+            
+            admitProcess(spec) {
+                const process = {
+                    id: this.processes.length + 1,
+                    name: spec.name,
+                    type: spec.type,
+                    priority: spec.priority,
+                    cpuNeed: spec.cpuNeed,
+                    memoryNeed: spec.memoryNeed,
+                    ioNeed: spec.ioNeed,
+                    cpuAllocated: 0,
+                    memoryAllocated: 0,
+                    ioAllocated: 0,
+                    burstTime: spec.burstTime,
+                    remainingTime: spec.burstTime,
+                    status: "waiting",
+                    waitTime: 0,
+                    arrivalTime: this.time,
+                    completionTime: null,
+                    pageFaults: 0
+                };
+                
+                this.processes.push(process);
+                this.scheduler.admit(process);
+                return process;
+            }
+            
+            // Add a random process; `typeWeights` optionally skews the processTypes mix
+            addRandomProcess(typeWeights) {
+                if (this.trace) this.trace.randomArrival(this.processes.length + 1, typeWeights);
+                const random = this.random;
+                const resources = this.resources;
+                const processType = typeWeights ?
+                    pickWeighted(processTypes, typeWeights, random()) :
+                    processTypes[Math.floor(random() * processTypes.length)];
+                const name = processNames[Math.floor(random() * processNames.length)];
+                const priority = Math.floor(random() * 10) + 1; // 1-10
+                const cpuNeed = Math.min(Math.floor(random() * resources.cpu * processType.cpuMultiplier) + 1, resources.cpu);
+                const memoryNeed = Math.min(Math.floor(random() * (resources.memory / 4) * processType.memoryMultiplier) + 50, resources.memory);
+                const ioNeed = Math.min(Math.floor(random() * resources.io * processType.ioMultiplier) + 1, resources.io);
+                const burstTime = Math.floor(random() * 10) + 3; // 3-12 seconds
+                
+                const process = this.admitProcess({
+                    name: `${name} (${processType.name})`,
+                    type: processType.name,
+                    priority: priority,
+                    cpuNeed: cpuNeed,
+                    memoryNeed: memoryNeed,
+                    ioNeed: ioNeed,
+                    burstTime: burstTime
+                });
+                
+                if (this.log) this.log(`Process ${process.id} (${process.name}) created with priority ${priority}`, "info");
+                return process;
+            }
+            
+            // Returns false if the process does not exist or already finished
+            terminateProcess(processId) {
+                if (this.trace) this.trace.terminate(processId);
+                const process = this.scheduler.get(processId);
+                return process !== undefined && this.scheduler.terminate(process);
+            }
+            
+            // Advance one tick: execute, allocate, then check for deadlocks.
+            // `deadlockMode` is 'on' (detect), 'avoid' (detect, and refuse
+            // grants that fail the Banker's safety check) or 'off'.
+            // Returns true if a deadlock was detected and broken.
+            step(algorithm, deadlockMode) {
+                const profiler = this.profiler || idleProfiler;
+                if (this.trace) this.trace.step(algorithm, deadlockMode);
+                this.time++;
+                profiler.begin("execute");
+                this.executeProcesses();
+                profiler.end();
+                profiler.begin("allocate");
+                this.scheduler.grantGuard = deadlockMode === 'avoid' ? this.bankersCheck : null;
+                this.allocateResources(algorithm);
+                profiler.end();
+                if (deadlockMode !== 'on' && deadlockMode !== 'avoid') return false;
+                profiler.begin("deadlock");
+                const deadlock = this.checkForDeadlocks();
+                profiler.end();
+                return deadlock;
+            }
+            
+            // ==============================
+            // RESOURCE ALLOCATION ALGORITHMS
+            // ==============================
+            
+            grantLogged(label) {
+                return process => {
+                    this.stats.contextSwitches++;
+                    if (this.trace) this.trace.grant(process.id);
+                    if (this.log) this.log(`Process ${process.id} allocated resources (${label(process)})`, "success");
+                };
+            }
+            
+            // Adaptive resource allocation algorithm: priority, then wait time, then resource needs
+            allocateResourcesAdaptive() {
+                this.scheduler.allocate('adaptive', this.grantLogged(process =>
+                    `CPU: ${process.cpuNeed}, Memory: ${process.memoryNeed}MB, I/O: ${process.ioNeed}`));
+            }
+            
+            // Round Robin allocation: first process in arrival order that fits, one per cycle
+            allocateResourcesRoundRobin() {
+                this.scheduler.allocate('roundrobin', this.grantLogged(() => "Round Robin"));
+            }
+            
+            // Priority-based allocation: highest priority processes that fit
+            allocateResourcesPriority() {
+                this.scheduler.allocate('priority', this.grantLogged(() => "Priority"));
+            }
+            
+            // First Come First Serve allocation: processes in order of arrival
+            allocateResourcesFCFS() {
+                this.scheduler.allocate('fcfs', this.grantLogged(() => "FCFS"));
+            }
+            
+            // Backfilling allocation: FCFS with a reserved start for the blocked head,
+            // smaller processes packed into the gaps around it
+            allocateResourcesBackfill() {
+                this.scheduler.allocate('backfill', this.grantLogged(() => "Backfill"));
+            }
+            
+            // Main allocation function that calls the appropriate algorithm
+            allocateResources(algorithm) {
+                switch(algorithm) {
+                    case 'adaptive':
+                        this.allocateResourcesAdaptive();
+                        break;
+                    case 'roundrobin':
+                        this.allocateResourcesRoundRobin();
+                        break;
+                    case 'priority':
+                        this.allocateResourcesPriority();
+                        break;
+                    case 'fcfs':
+                        this.allocateResourcesFCFS();
+                        break;
+                    case 'backfill':
+                        this.allocateResourcesBackfill();
+                        break;
+                    default:
+                        this.allocateResourcesAdaptive();
+                }
+            }
+            
+            // ==============================
+            // DEADLOCK DETECTION
+            // ==============================
+            
+            checkForDeadlocks() {
+                const scheduler = this.scheduler;
+                
+                // A long wait is starvation, not deadlock: report it once, as the
+                // process crosses the threshold, and leave it alone. Processes
+                // only wait from arrival, so they cross in arrival order. Past
+                // STARVATION_WARNINGS_PER_TICK the rest are summed into one line.
+                const processes = this.processes;
+                let starving = 0;
+                while (this.starvationCursor < processes.length &&
+                       this.time - processes[this.starvationCursor].arrivalTime > this.starvationThreshold) {
+                    const process = processes[this.starvationCursor++];
+                    if (process.status === "waiting" && this.log && ++starving <= STARVATION_WARNINGS_PER_TICK) {
+                        this.log(`Warning: Process ${process.id} has been waiting for ${scheduler.waitTimeOf(process)}s - possible starvation`, "warning");
+                    }
+                }
+                if (starving > STARVATION_WARNINGS_PER_TICK) {
+                    this.log(`Warning: ${starving - STARVATION_WARNINGS_PER_TICK} more processes have been waiting over ${this.starvationThreshold}s - possible starvation`, "warning");
+                }
+                
+                // Deadlock only when the allocation graph has an irreducible cycle
+                const deadlocked = scheduler.graph.detect();
+                if (deadlocked.length === 0) return false;
+                
+                this.stats.deadlocks++;
+                if (this.log) this.log(`DEADLOCK DETECTED! ${deadlocked.length} processes are blocked in a wait-for cycle`, "error");
+                
+                // Terminate the lowest priority process on the cycle to break it
+                const victim = deadlocked.reduce((lowest, process) => process.priority < lowest.priority ? process : lowest);
+                scheduler.terminate(victim);
+                if (this.trace) this.trace.kill(victim.id);
+                if (this.log) this.log(`Process ${victim.id} terminated to break deadlock`, "error");
+                return true;
+            }
+            
+            // ==============================
+            // PROCESS EXECUTION
+            // ==============================
+            
+            executeProcesses() {
+                // Waiting processes age lazily in the scheduler, so only the running set is visited
+                this.scheduler.running.forEach(process => {
+                    process.remainingTime -= 1;
+                    
+                    // Simulate page faults for memory-intensive processes
+                    if (process.type === "Memory Intensive" && this.random() < 0.1) {
+                        process.pageFaults++;
+                        this.stats.pageFaults++;
+                        if (this.log) this.log(`Page fault occurred in Process ${process.id}`, "warning");
                     }
                     
                     // If process completed its execution
                     if (process.remainingTime <= 0) {
-                        process.status = "completed";
-                        process.completionTime = simulationTime;
-                        completedProcesses++;
+                        this.scheduler.complete(process);
+                        this.stats.completed++;
+                        if (this.trace) this.trace.complete(process.id);
                         
                         // Calculate turnaround time
-                        const turnaroundTime = simulationTime - process.arrivalTime;
-                        totalTurnaroundTime += turnaroundTime;
+                        const turnaroundTime = this.time - process.arrivalTime;
+                        this.stats.totalTurnaroundTime += turnaroundTime;
                         
-                        addLog(`Process ${process.id} completed execution (Turnaround: ${turnaroundTime}s)`, "info");
+                        if (this.log) this.log(`Process ${process.id} completed execution (Turnaround: ${turnaroundTime}s)`, "info");
                     }
-                } else if (process.status === "waiting") {
-                    process.waitTime += 1;
-                    totalWaitTime += 1;
+                });
+            }
+        }
+        
+        // Pick an item using relative weights (same order as `items`)
+        function pickWeighted(items, weights, roll) {
+            const total = weights.reduce((sum, weight) => sum + weight, 0);
+            let threshold = roll * total;
+            for (let i = 0; i < items.length; i++) {
+                threshold -= weights[i];
+                if (threshold < 0) return items[i];
+            }
+            return items[items.length - 1];
+        }
+        
+        // ==============================
+        // PROCESS TABLE
+        // ==============================
+        
+        // Enum codes for `status`; `type` is coded by its index in processTypes
+        const processStatuses = ["waiting", "running", "completed", "terminated"];
+        
+        // Integer fields carried per process. An encoded row is the process's
+        // index, these columns, then its status and type codes.
+        const processColumns = [
+            "id", "priority", "cpuNeed", "memoryNeed", "ioNeed",
+            "cpuAllocated", "memoryAllocated", "ioAllocated",
+            "burstTime", "remainingTime", "waitTime", "waitingSince",
+            "arrivalTime", "completionTime", "pageFaults"
+        ];
+        const PROCESS_ROW_STRIDE = processColumns.length + 3;
+        
+        // Pack process objects into one flat Int32Array (null becomes -1)
+        function encodeProcessRows(list) {
+            const rows = new Int32Array(list.length * PROCESS_ROW_STRIDE);
+            let offset = 0;
+            list.forEach(process => {
+                rows[offset++] = process.id - 1;
+                processColumns.forEach(column => {
+                    rows[offset++] = process[column] === null ? -1 : process[column];
+                });
+                rows[offset++] = processStatuses.indexOf(process.status);
+                rows[offset++] = processTypes.findIndex(type => type.name === process.type);
+            });
+            return rows;
+        }
+        
+        // Structure-of-arrays copy of a process list: one typed array per
+        // column (`table.remainingTime[i]`), status and type as byte codes,
+        // kept current by applying encoded rows
+        class ProcessTable {
+            constructor() {
+                this.length = 0;
+                this.capacity = 0;
+                this.names = [];
+                this.grow(1024);
+            }
+            
+            grow(capacity) {
+                const copy = (from, to) => { to.set(from.subarray(0, this.length)); return to; };
+                processColumns.forEach(column => {
+                    this[column] = this.capacity > 0 ? copy(this[column], new Int32Array(capacity)) : new Int32Array(capacity);
+                });
+                this.status = this.capacity > 0 ? copy(this.status, new Uint8Array(capacity)) : new Uint8Array(capacity);
+                this.type = this.capacity > 0 ? copy(this.type, new Uint8Array(capacity)) : new Uint8Array(capacity);
+                this.capacity = capacity;
+            }
+            
+            clear() {
+                this.length = 0;
+                this.names = [];
+            }
+            
+            // `names` holds the names of the rows added since the last update
+            apply(length, rows, names) {
+                if (length > this.capacity) this.grow(Math.max(length, this.capacity * 2));
+                this.length = length;
+                names.forEach(name => this.names.push(name));
+                
+                const columnCount = processColumns.length;
+                for (let offset = 0; offset < rows.length; offset += PROCESS_ROW_STRIDE) {
+                    const index = rows[offset];
+                    for (let c = 0; c < columnCount; c++) {
+                        this[processColumns[c]][index] = rows[offset + 1 + c];
+                    }
+                    this.status[index] = rows[offset + 1 + columnCount];
+                    this.type[index] = rows[offset + 2 + columnCount];
+                }
+            }
+            
+            statusOf(index) {
+                return processStatuses[this.status[index]];
+            }
+            
+            typeOf(index) {
+                return processTypes[this.type[index]].name;
+            }
+            
+            waitTimeOf(index, now) {
+                return this.status[index] === 0 ?
+                    this.waitTime[index] + (now - this.waitingSince[index]) :
+                    this.waitTime[index];
+            }
+        }
+        
+        // Fixed-capacity ring of log lines waiting to be shown. When more
+        // arrive than it holds, the oldest unseen lines are overwritten.
+        class LogRing {
+            constructor(capacity) {
+                this.capacity = capacity;
+                this.entries = new Array(capacity);
+                this.next = 0;
+                this.pending = 0;
+            }
+            
+            push(entry) {
+                this.entries[this.next] = entry;
+                this.next = (this.next + 1) % this.capacity;
+                this.pending = Math.min(this.pending + 1, this.capacity);
+            }
+            
+            // Pending lines, oldest first
+            drain() {
+                const drained = [];
+                for (let i = this.pending; i > 0; i--) {
+                    drained.push(this.entries[(this.next - i + this.capacity) % this.capacity]);
+                }
+                this.pending = 0;
+                return drained;
+            }
+            
+            clear() {
+                this.pending = 0;
+            }
+        }
+        
+        // ==============================
+        // SIMULATION HOST
+        // ==============================
+        
+        // Drives a SimulationEngine through messages so it can run in a Web
+        // Worker. Each command is answered with one `post(delta, transfer)`:
+        // the processes that changed as encoded rows, names of new processes,
+        // log lines and the counters. Waiting processes age lazily, so a tick's
+        // delta only holds state transitions and the running set. While a trace
+        // is recorded its finished chunks ride along, and every tick is timed
+        // by phase for the profile.
+        function createSimulationHost(post) {
+            let engine = null;
+            let generation = 0;
+            let named = 0;
+            let trace = null;
+            let traceChunks = [];
+            const logs = new LogRing(500);
+            const profiler = new PhaseProfiler();
+            
+            function publish(extra) {
+                const scheduler = engine.scheduler;
+                scheduler.running.forEach(process => scheduler.changed.add(process));
+                const rows = encodeProcessRows(Array.from(scheduler.changed));
+                scheduler.changed.clear();
+                
+                const names = engine.processes.slice(named).map(process => process.name);
+                named = engine.processes.length;
+                
+                const chunks = traceChunks;
+                traceChunks = [];
+                
+                post(Object.assign({
+                    generation: generation,
+                    time: engine.time,
+                    length: engine.processes.length,
+                    rows: rows,
+                    names: names,
+                    logs: logs.drain(),
+                    resources: Object.assign({}, engine.resources),
+                    counts: Object.assign({}, scheduler.counts),
+                    stats: Object.assign({}, engine.stats, { deferred: Object.assign({}, engine.stats.deferred) }),
+                    totalWaitTime: scheduler.totalWaitTime(),
+                    trace: chunks
+                }, extra), [rows.buffer].concat(chunks.map(chunk => chunk.buffer)));
+            }
+            
+            return command => {
+                switch (command.type) {
+                    case "init":
+                        // A reset while recording starts the next run in the same trace
+                        if (trace !== null) trace.end(engine.time);
+                        if (!command.trace) trace = null;
+                        generation = command.generation;
+                        named = 0;
+                        logs.clear();
+                        profiler.clear();
+                        engine = new SimulationEngine({ cpu: command.cpu, memory: command.memory, io: command.io, seed: command.seed, profiler: profiler });
+                        engine.scheduler.changed = new Set();
+                        if (command.trace) {
+                            if (trace === null) trace = new TraceWriter(chunk => traceChunks.push(chunk));
+                            engine.startTrace(trace);
+                        }
+                        for (let i = 0; i < command.count; i++) {
+                            engine.addRandomProcess();
+                        }
+                        engine.log = (message, type) => logs.push({ time: engine.time, message: message, type: type });
+                        publish({ reset: true });
+                        break;
+                    case "step": {
+                        profiler.begin("tick");
+                        const deadlock = engine.step(command.algorithm, command.deadlockMode);
+                        profiler.begin("serialize");
+                        publish({ step: true, deadlock: deadlock });
+                        profiler.end();
+                        profiler.end();
+                        break;
+                    }
+                    case "addRandom":
+                        publish({ added: engine.addRandomProcess().id, tag: command.tag });
+                        break;
+                    case "addProcess":
+                        publish({ added: engine.addProcess(command.spec).id, tag: command.tag });
+                        break;
+                    case "terminate":
+                        publish({ terminated: engine.terminateProcess(command.id) ? command.id : null });
+                        break;
+                    case "stopTrace":
+                        if (trace !== null) {
+                            trace.end(engine.time);
+                            engine.trace = null;
+                            trace = null;
+                        }
+                        publish({ traceEnd: true });
+                        break;
+                    case "profile":
+                        publish({ profile: profiler.folded("worker") });
+                        break;
                 }
+            };
+        }
+    </script>
+
+    <script>
+        // ==============================
+        // GLOBAL VARIABLES AND CONSTANTS
+        // ==============================
+        let simulationInterval;
+        let isRunning = false;
+        let processes = new ProcessTable();
+        let resources = {
+            cpu: 2,
+            memory: 512,
+            io: 3,
+            allocatedCPU: 0,
+            allocatedMemory: 0,
+            allocatedIO: 0
+        };
+        let resourceHistory = [];
+        let processStatusCounts = { running: 0, waiting: 0, completed: 0, terminated: 0 };
+        let autoAddInterval;
+        
+        // Page-side view of the engine, refreshed by every delta it posts
+        let simulation = {
+            time: 0,
+            totalWaitTime: 0,
+            stats: { completed: 0, totalTurnaroundTime: 0, contextSwitches: 0, pageFaults: 0, deadlocks: 0,
+                     deferred: { cpu: 0, memory: 0, io: 0, unsafe: 0, reservation: 0 } }
+        };
+        let generation = 0;
+        let stepInFlight = false;
+        
+        // Trace recording and profiling
+        let traceRecording = false;
+        let traceSink = null;
+        const renderProfiler = new PhaseProfiler();
+        
+        // Render scheduling and timing
+        let renderPending = false;
+        let frameTime = 0;
+        let tickDrift = 0;
+        let lastTickAt = 0;
+        
+        // Chart instances
+        let resourceChart, processChart;
+        
+        // DOM elements
+        const processCountInput = document.getElementById('process-count');
+        const algorithmSelect = document.getElementById('algorithm');
+        const timeSliceInput = document.getElementById('time-slice');
+        const cpuCountInput = document.getElementById('cpu-count');
+        const memorySizeInput = document.getElementById('memory-size');
+        const ioDevicesInput = document.getElementById('io-devices');
+        const autoAddSelect = document.getElementById('auto-add');
+        const deadlockDetectionSelect = document.getElementById('deadlock-detection');
+        const startBtn = document.getElementById('start-btn');
+        const pauseBtn = document.getElementById('pause-btn');
+        const resetBtn = document.getElementById('reset-btn');
+        const addProcessBtn = document.getElementById('add-process-btn');
+        const algoInfoBtn = document.getElementById('algo-info-btn');
+        const traceBtn = document.getElementById('trace-btn');
+        const profileBtn = document.getElementById('profile-btn');
+        const clearLogBtn = document.getElementById('clear-log-btn');
+        const processList = document.getElementById('process-list');
+        const resourceList = document.getElementById('resource-list');
+        const systemLog = document.getElementById('system-log');
+        const simulationTimeElement = document.getElementById('simulation-time');
+        const cpuUtilElement = document.getElementById('cpu-util');
+        const totalProcessesElement = document.getElementById('total-processes');
+        const allocationTableBody = document.getElementById('allocation-table-body');
+        const allocationTableViewport = document.getElementById('allocation-table-viewport');
+        const frameTimeElement = document.getElementById('frame-time');
+        const tickDriftElement = document.getElementById('tick-drift');
+        const currentAlgorithmElement = document.getElementById('current-algorithm');
+        const deadlockWarningElement = document.getElementById('deadlock-warning');
+        const algorithmModal = document.getElementById('algorithmModal');
+        const closeModal = document.querySelector('.close-modal');
+        const algorithmDetails = document.getElementById('algorithmDetails');
+        
+        // Metric elements
+        const metricCpuElement = document.getElementById('metric-cpu');
+        const metricMemoryElement = document.getElementById('metric-memory');
+        const metricThroughputElement = document.getElementById('metric-throughput');
+        const metricWaitElement = document.getElementById('metric-wait');
+        
+        // Stat elements
+        const statContextSwitch = document.getElementById('stat-context-switch');
+        const statPageFaults = document.getElementById('stat-page-faults');
+        const statDeadlocks = document.getElementById('stat-deadlocks');
+        const statDeferred = document.getElementById('stat-deferred');
+        
+        // ==============================
+        // INITIALIZATION FUNCTIONS
+        // ==============================
+        
+        // Initialize the simulation
+        function initSimulation() {
+            clearInterval(simulationInterval);
+            clearInterval(autoAddInterval);
+            
+            // Set resources based on inputs and have the engine generate the
+            // initial processes; deltas from an earlier run are ignored. The
+            // log is cleared now, so lines logged before the engine answers stay.
+            generation++;
+            stepInFlight = false;
+            clearLog();
+            sendToSimulation({
+                type: "init",
+                generation: generation,
+                cpu: parseInt(cpuCountInput.value),
+                memory: parseInt(memorySizeInput.value),
+                io: parseInt(ioDevicesInput.value),
+                count: parseInt(processCountInput.value),
+                seed: Math.floor(Math.random() * 4294967296),
+                trace: traceRecording
             });
+            
+            // Hide deadlock warning
+            deadlockWarningElement.style.display = 'none';
+        }
+        
+        // The engine runs in a Web Worker built from the page's own engine
+        // script. Where workers are unavailable it runs in-page behind the
+        // same messages, answering asynchronously just like the worker.
+        function startSimulationHost() {
+            const source = document.getElementById('simulation-engine').textContent;
+            try {
+                const workerSource = source +
+                    "\n;const host = createSimulationHost((delta, transfer) => postMessage(delta, transfer));" +
+                    "\nonmessage = event => host(event.data);";
+                const worker = new Worker(URL.createObjectURL(new Blob([workerSource], { type: "text/javascript" })));
+                worker.onmessage = event => onSimulationDelta(event.data);
+                return command => worker.postMessage(command);
+            } catch (error) {
+                const host = createSimulationHost(delta => setTimeout(() => onSimulationDelta(delta), 0));
+                return command => host(command);
+            }
         }
         
+        const sendToSimulation = startSimulationHost();
+        
+        // Mirror one delta from the engine into the page state
+        function onSimulationDelta(delta) {
+            // Trace chunks and profiles belong to the recording, not to a run
+            if (traceSink !== null && delta.trace.length > 0) traceSink.write(delta.trace);
+            if (delta.traceEnd) finishTrace();
+            if (delta.profile !== undefined) saveProfile(delta.profile);
+            if (delta.generation !== generation) return;
+            
+            if (delta.reset) processes.clear();
+            processes.apply(delta.length, delta.rows, delta.names);
+            simulation.time = delta.time;
+            simulation.stats = delta.stats;
+            simulation.totalWaitTime = delta.totalWaitTime;
+            Object.assign(resources, delta.resources);
+            Object.assign(processStatusCounts, delta.counts);
+            delta.logs.forEach(entry => logBuffer.push(entry));
+            
+            if (delta.reset) {
+                // Initialize resource history
+                resourceHistory = [];
+                updateResourceHistory();
+                addLog("System initialized with " + delta.length + " processes", "info");
+            }
+            if (delta.tag === "auto") {
+                addLog(`Auto-added new process (Total: ${delta.length})`, "info");
+            } else if (delta.tag === "custom") {
+                addLog(`Custom process ${delta.added} added to the system`, "info");
+            }
+            if (delta.terminated) {
+                addLog(`Process ${delta.terminated} terminated manually`, "warning");
+            }
+            if (delta.step) {
+                stepInFlight = false;
+                onTick(delta.deadlock);
+            }
+            
+            // Update UI on the next frame
+            scheduleRender();
+        }
+        
+        
         // ==============================
-        // UI UPDATE FUNCTIONS
+        // PROCESS MANAGEMENT FUNCTIONS
+        // ==============================
+        
+        // Add a random process; `tag` picks the log line once it exists
+        function addRandomProcess(tag) {
+            sendToSimulation({ type: "addRandom", tag: tag });
+        }
+        
+        // Add a custom process
+        function addCustomProcess() {
+            const processType = processTypes[Math.floor(Math.random() * processTypes.length)];
+            const name = "Custom Process " + (processes.length + 1);
+            const priority = Math.floor(Math.random() * 10) + 1;
+            const cpuNeed = Math.min(Math.floor(Math.random() * resources.cpu) + 1, resources.cpu);
+            const memoryNeed = Math.min(Math.floor(Math.random() * 100) + 50, resources.memory);
+            const ioNeed = Math.min(Math.floor(Math.random() * resources.io) + 1, resources.io);
+            const burstTime = Math.floor(Math.random() * 8) + 2;
+            
+            sendToSimulation({ type: "addProcess", tag: "custom", spec: {
+                name: `${name} (${processType.name})`,
+                type: processType.name,
+                priority: priority,
+                cpuNeed: cpuNeed,
+                memoryNeed: memoryNeed,
+                ioNeed: ioNeed,
+                burstTime: burstTime
+            } });
+        }
+        
+        // Terminate a process
+        function terminateProcess(processId) {
+            // Frees any held resources and leaves the scheduler queues
+            sendToSimulation({ type: "terminate", id: processId });
+        }
+        
+        // ==============================
+        // SIMULATION STEP
+        // ==============================
+        
+        // Ask the engine for one tick. A tick still being computed is not
+        // queued behind, so a slow engine shows up as tick drift, not a frozen page.
+        function stepSimulation() {
+            if (stepInFlight) return false;
+            stepInFlight = true;
+            sendToSimulation({ type: "step", algorithm: algorithmSelect.value, deadlockMode: deadlockDetectionSelect.value });
+            return true;
+        }
+        
+        // A tick finished: reflect deadlock handling and check for the end of the run
+        function onTick(deadlock) {
+            // How late this tick landed relative to the configured quantum
+            const now = performance.now();
+            if (lastTickAt > 0) {
+                tickDrift = smooth(tickDrift, now - lastTickAt - parseInt(timeSliceInput.value));
+            }
+            lastTickAt = now;
+            
+            if (deadlockDetectionSelect.value !== 'off') {
+                deadlockWarningElement.style.display = deadlock ? 'block' : 'none';
+            }
+            updateResourceHistory();
+            
+            // Add periodic log
+            if (simulation.time % 5 === 0) {
+                addLog(`System check: ${processStatusCounts.running} running, ${processStatusCounts.waiting} waiting, ${processStatusCounts.completed} completed`, "info");
+            }
+            
+            // Check if all processes are completed
+            if (isRunning && processStatusCounts.completed + processStatusCounts.terminated === processes.length && processes.length > 0) {
+                addLog("All processes completed. Simulation finished.", "success");
+                pauseSimulation();
+            }
+        }
+        
+        // ==============================
+        // RENDER LAYER
         // ==============================
         
-        function updateProcessStatusCounts() {
-            processStatusCounts = {
-                running: processes.filter(p => p.status === "running").length,
-                waiting: processes.filter(p => p.status === "waiting").length,
-                completed: processes.filter(p => p.status === "completed").length,
-                terminated: processes.filter(p => p.status === "terminated").length
+        // Ticks only advance the engine; the DOM is brought up to date at most
+        // once per animation frame, however many ticks or log lines came in between
+        function scheduleRender() {
+            if (renderPending) return;
+            renderPending = true;
+            requestAnimationFrame(renderFrame);
+        }
+        
+        function renderFrame() {
+            renderPending = false;
+            const start = performance.now();
+            renderProfiler.begin("render");
+            
+            simulationTimeElement.textContent = "Time: " + simulation.time + "s";
+            updateTotalProcessesDisplay();
+            currentAlgorithmElement.textContent = algorithmSelect.options[algorithmSelect.selectedIndex].text;
+            renderProfiler.begin("lists");
+            updateProcessList();
+            updateResourceList();
+            updateAllocationTable();
+            renderProfiler.end();
+            updateMetrics();
+            updateStats();
+            renderProfiler.begin("charts");
+            updateCharts();
+            renderProfiler.end();
+            renderProfiler.begin("log");
+            flushLog();
+            renderProfiler.end();
+            
+            renderProfiler.end();
+            frameTime = smooth(frameTime, performance.now() - start);
+            frameTimeElement.textContent = frameTime.toFixed(1) + "ms";
+            tickDriftElement.textContent = (tickDrift >= 0 ? "+" : "") + tickDrift.toFixed(1) + "ms";
+        }
+        
+        // Exponential moving average for the timing readouts
+        function smooth(average, sample) {
+            return average + (sample - average) * 0.1;
+        }
+        
+        // Apply `value` to a pooled row only if it differs from what the row
+        // currently shows, so unchanged rows cost no DOM writes
+        function patch(row, key, value, apply) {
+            if (row.shown[key] === value) return;
+            row.shown[key] = value;
+            apply(value);
+        }
+        
+        function patchText(row, key, text) {
+            if (row.shown[key] === text) return;
+            row.shown[key] = text;
+            row.parts[key].textContent = text;
+        }
+        
+        // Scrolling list that keeps only the rows in view (plus `overscan`)
+        // in the DOM. Spacers stand in for the rows above and below, and the
+        // row elements are pooled and re-bound to whichever indices they show.
+        class VirtualList {
+            constructor(viewport, content, options) {
+                this.viewport = viewport;
+                this.content = content;
+                this.createRow = options.createRow;
+                this.renderRow = options.renderRow;
+                this.setSpacer = options.setSpacer;
+                this.rowHeight = options.rowHeight;
+                this.overscan = 4;
+                this.measured = false;
+                this.rows = [];
+                this.topSpacer = options.createSpacer();
+                this.bottomSpacer = options.createSpacer();
+                this.reset();
+            }
+            
+            reset() {
+                this.rows = [];
+                this.content.replaceChildren(this.topSpacer, this.bottomSpacer);
+            }
+            
+            render(length) {
+                // Read layout before any writes
+                const scrollTop = this.viewport.scrollTop;
+                const height = this.viewport.clientHeight || this.rowHeight * 10;
+                
+                const first = Math.min(length, Math.max(0, Math.floor(scrollTop / this.rowHeight) - this.overscan));
+                const last = Math.min(length, Math.ceil((scrollTop + height) / this.rowHeight) + this.overscan);
+                const count = Math.max(0, last - first);
+                
+                while (this.rows.length < count) {
+                    const row = this.createRow();
+                    this.content.insertBefore(row, this.bottomSpacer);
+                    this.rows.push(row);
+                }
+                while (this.rows.length > count) {
+                    this.rows.pop().remove();
+                }
+                for (let i = 0; i < count; i++) {
+                    this.renderRow(this.rows[i], first + i);
+                }
+                this.setSpacer(this.topSpacer, first * this.rowHeight);
+                this.setSpacer(this.bottomSpacer, (length - last) * this.rowHeight);
+                
+                // Rows share one height; take the real pitch from the first two
+                if (!this.measured && count >= 2) {
+                    const pitch = this.rows[1].offsetTop - this.rows[0].offsetTop;
+                    if (pitch > 0) this.rowHeight = pitch;
+                    this.measured = true;
+                }
+            }
+        }
+        
+        // The log panel keeps at most this many entries
+        const logBuffer = new LogRing(500);
+        
+        function createProcessRow() {
+            const row = document.createElement("div");
+            row.innerHTML = `
+                <div class="process-info">
+                    <div class="process-name"></div>
+                    <div class="process-meta"></div>
+                    <div class="process-allocation"></div>
+                    <div style="margin-top: 5px; width: 100%; height: 5px; background: #ddd; border-radius: 3px;">
+                        <div class="process-progress" style="height: 100%; background: var(--secondary-color); border-radius: 3px;"></div>
+                    </div>
+                </div>
+                <div>
+                    <span class="process-status"></span>
+                    <div class="process-remaining" style="margin-top: 5px; font-size: 0.9rem;"></div>
+                    <button class="terminate-btn" style="margin-top: 5px; padding: 3px 8px; font-size: 0.8rem; background: var(--accent-color);">Terminate</button>
+                </div>
+            `;
+            row.parts = {
+                name: row.querySelector(".process-name"),
+                meta: row.querySelector(".process-meta"),
+                allocation: row.querySelector(".process-allocation"),
+                progress: row.querySelector(".process-progress"),
+                status: row.querySelector(".process-status"),
+                remaining: row.querySelector(".process-remaining"),
+                terminate: row.querySelector(".terminate-btn")
+            };
+            row.shown = {};
+            return row;
+        }
+        
+        function renderProcessRow(row, index) {
+            const parts = row.parts;
+            const id = processes.id[index];
+            const progressPercent = ((processes.burstTime[index] - processes.remainingTime[index]) / processes.burstTime[index]) * 100;
+            
+            patch(row, "status", processes.statusOf(index), status => {
+                row.className = `process-item ${status}`;
+                parts.status.className = `process-status status-${status}`;
+                parts.status.textContent = status.toUpperCase();
+                // Hidden rather than removed so every row keeps the same height
+                parts.terminate.style.visibility = status === "waiting" ? "visible" : "hidden";
+            });
+            patch(row, "id", id, value => { parts.terminate.dataset.processId = value; });
+            patchText(row, "name", `${id}. ${processes.names[index]}`);
+            patchText(row, "meta", `Priority: ${processes.priority[index]} | Type: ${processes.typeOf(index)}`);
+            patchText(row, "allocation", `CPU: ${processes.cpuAllocated[index]}/${processes.cpuNeed[index]} | Memory: ${processes.memoryAllocated[index]}MB/${processes.memoryNeed[index]}MB`);
+            patch(row, "progress", progressPercent, percent => { parts.progress.style.width = percent + "%"; });
+            patchText(row, "remaining", `${processes.remainingTime[index]}s remaining`);
+        }
+        
+        function createAllocationRow() {
+            const row = document.createElement("tr");
+            row.innerHTML = `
+                <td></td>
+                <td></td>
+                <td><span class="process-status"></span></td>
+                <td></td>
+                <td></td>
+                <td></td>
+                <td></td>
+                <td></td>
+                <td></td>
+            `;
+            const cells = row.querySelectorAll("td");
+            row.parts = {
+                id: cells[0],
+                name: cells[1],
+                status: cells[2].firstElementChild,
+                priority: cells[3],
+                cpu: cells[4],
+                memory: cells[5],
+                io: cells[6],
+                wait: cells[7],
+                turnaround: cells[8]
             };
+            row.shown = {};
+            return row;
+        }
+        
+        function renderAllocationRow(row, index) {
+            const turnaroundTime = processes.completionTime[index] > 0 ?
+                processes.completionTime[index] - processes.arrivalTime[index] :
+                simulation.time - processes.arrivalTime[index];
+            
+            patch(row, "status", processes.statusOf(index), status => {
+                row.parts.status.className = `process-status status-${status}`;
+                row.parts.status.textContent = status.toUpperCase();
+            });
+            patchText(row, "id", String(processes.id[index]));
+            patchText(row, "name", processes.names[index]);
+            patchText(row, "priority", String(processes.priority[index]));
+            patchText(row, "cpu", `${processes.cpuAllocated[index]}/${processes.cpuNeed[index]}`);
+            patchText(row, "memory", `${processes.memoryAllocated[index]}MB/${processes.memoryNeed[index]}MB`);
+            patchText(row, "io", `${processes.ioAllocated[index]}/${processes.ioNeed[index]}`);
+            patchText(row, "wait", `${processes.waitTimeOf(index, simulation.time)}s`);
+            patchText(row, "turnaround", `${turnaroundTime}s`);
         }
         
+        const processListView = new VirtualList(processList, processList, {
+            rowHeight: 110,
+            createRow: createProcessRow,
+            renderRow: renderProcessRow,
+            createSpacer: () => document.createElement("div"),
+            setSpacer: (spacer, height) => { spacer.style.height = height + "px"; }
+        });
+        
+        const allocationTableView = new VirtualList(allocationTableViewport, allocationTableBody, {
+            rowHeight: 46,
+            createRow: createAllocationRow,
+            renderRow: renderAllocationRow,
+            createSpacer: () => {
+                const spacer = document.createElement("tr");
+                spacer.innerHTML = `<td colspan="9" style="padding: 0; border: 0;"></td>`;
+                return spacer;
+            },
+            setSpacer: (spacer, height) => { spacer.style.height = height + "px"; }
+        });
+        
+        // ==============================
+        // UI UPDATE FUNCTIONS
+        // ==============================
+        
         function updateResourceHistory() {
             resourceHistory.push({
-                time: simulationTime,
+                time: simulation.time,
                 cpu: (resources.allocatedCPU / resources.cpu) * 100,
                 memory: (resources.allocatedMemory / resources.memory) * 100,
                 io: (resources.allocatedIO / resources.io) * 100
@@ -1273,40 +2897,10 @@
         }
         
         function updateProcessList() {
-            processList.innerHTML = "";
-            
-            processes.forEach(process => {
-                const processElement = document.createElement("div");
-                processElement.className = `process-item ${process.status}`;
-                
-                const statusClass = `status-${process.status}`;
-                const progressPercent = ((process.burstTime - process.remainingTime) / process.burstTime) * 100;
-                
-                processElement.innerHTML = `
-                    <div class="process-info">
-                        <div class="process-name">${process.id}. ${process.name}</div>
-                        <div>Priority: ${process.priority} | Type: ${process.type}</div>
-                        <div>CPU: ${process.cpuAllocated}/${process.cpuNeed} | Memory: ${process.memoryAllocated}MB/${process.memoryNeed}MB</div>
-                        <div style="margin-top: 5px; width: 100%; height: 5px; background: #ddd; border-radius: 3px;">
-                            <div style="width: ${progressPercent}%; height: 100%; background: var(--secondary-color); border-radius: 3px;"></div>
-                        </div>
-                    </div>
-                    <div>
-                        <span class="process-status ${statusClass}">${process.status.toUpperCase()}</span>
-                        <div style="margin-top: 5px; font-size: 0.9rem;">${process.remainingTime}s remaining</div>
-                        ${process.status === "waiting" ? 
-                          `<button onclick="terminateProcess(${process.id})" style="margin-top: 5px; padding: 3px 8px; font-size: 0.8rem; background: var(--accent-color);">Terminate</button>` : 
-                          ''}
-                    </div>
-                `;
-                
-                processList.appendChild(processElement);
-            });
+            processListView.render(processes.length);
         }
         
         function updateResourceList() {
-            resourceList.innerHTML = "";
-            
             const cpuUtilization = ((resources.allocatedCPU / resources.cpu) * 100).toFixed(1);
             const memoryUtilization = ((resources.allocatedMemory / resources.memory) * 100).toFixed(1);
             const ioUtilization = ((resources.allocatedIO / resources.io) * 100).toFixed(1);
@@ -1317,21 +2911,38 @@
                 { name: "I/O Devices", used: resources.allocatedIO, total: resources.io, utilization: ioUtilization }
             ];
             
-            resourcesData.forEach(resource => {
-                const resourceElement = document.createElement("div");
-                resourceElement.className = "resource-item";
-                
-                resourceElement.innerHTML = `
-                    <div class="resource-info">
-                        <div style="font-weight: 600; color: var(--primary-color);">${resource.name}</div>
-                        <div>${resource.used} / ${resource.total} (${resource.utilization}% utilized)</div>
-                    </div>
-                    <div style="width: 100px; height: 10px; background: #e0e0e0; border-radius: 5px; overflow: hidden;">
-                        <div style="width: ${resource.utilization}%; height: 100%; background: var(--secondary-color);"></div>
-                    </div>
-                `;
-                
-                resourceList.appendChild(resourceElement);
+            // The three rows are built once and patched in place afterwards
+            if (resourceList.children.length !== resourcesData.length) {
+                resourceList.innerHTML = "";
+                resourcesData.forEach(() => {
+                    const resourceElement = document.createElement("div");
+                    resourceElement.className = "resource-item";
+                    
+                    resourceElement.innerHTML = `
+                        <div class="resource-info">
+                            <div class="resource-name" style="font-weight: 600; color: var(--primary-color);"></div>
+                            <div class="resource-usage"></div>
+                        </div>
+                        <div style="width: 100px; height: 10px; background: #e0e0e0; border-radius: 5px; overflow: hidden;">
+                            <div class="resource-bar" style="height: 100%; background: var(--secondary-color);"></div>
+                        </div>
+                    `;
+                    resourceElement.parts = {
+                        name: resourceElement.querySelector(".resource-name"),
+                        usage: resourceElement.querySelector(".resource-usage"),
+                        bar: resourceElement.querySelector(".resource-bar")
+                    };
+                    resourceElement.shown = {};
+                    
+                    resourceList.appendChild(resourceElement);
+                });
+            }
+            
+            resourcesData.forEach((resource, index) => {
+                const row = resourceList.children[index];
+                patchText(row, "name", resource.name);
+                patchText(row, "usage", `${resource.used} / ${resource.total} (${resource.utilization}% utilized)`);
+                patch(row, "bar", resource.utilization, utilization => { row.parts.bar.style.width = utilization + "%"; });
             });
             
             // Update CPU utilization in header
@@ -1339,30 +2950,7 @@
         }
         
         function updateAllocationTable() {
-            allocationTableBody.innerHTML = "";
-            
-            processes.forEach(process => {
-                const row = document.createElement("tr");
-                
-                const statusClass = `status-${process.status}`;
-                const turnaroundTime = process.completionTime ? 
-                    process.completionTime - process.arrivalTime : 
-                    simulationTime - process.arrivalTime;
-                
-                row.innerHTML = `
-                    <td>${process.id}</td>
-                    <td>${process.name}</td>
-                    <td><span class="process-status ${statusClass}">${process.status.toUpperCase()}</span></td>
-                    <td>${process.priority}</td>
-                    <td>${process.cpuAllocated}/${process.cpuNeed}</td>
-                    <td>${process.memoryAllocated}MB/${process.memoryNeed}MB</td>
-                    <td>${process.ioAllocated}/${process.ioNeed}</td>
-                    <td>${process.waitTime}s</td>
-                    <td>${turnaroundTime}s</td>
-                `;
-                
-                allocationTableBody.appendChild(row);
-            });
+            allocationTableView.render(processes.length);
         }
         
         function updateMetrics() {
@@ -1370,12 +2958,12 @@
             const memoryUtilization = ((resources.allocatedMemory / resources.memory) * 100).toFixed(1);
             
             // Calculate throughput (processes completed per minute)
-            const throughput = completedProcesses > 0 ? 
-                ((completedProcesses / simulationTime) * 60).toFixed(1) : "0";
+            const throughput = simulation.stats.completed > 0 ? 
+                ((simulation.stats.completed / simulation.time) * 60).toFixed(1) : "0";
             
             // Calculate average wait time
             const avgWaitTime = processes.length > 0 ? 
-                (totalWaitTime / processes.length).toFixed(1) : "0";
+                (simulation.totalWaitTime / processes.length).toFixed(1) : "0";
             
             metricCpuElement.textContent = cpuUtilization + "%";
             metricMemoryElement.textContent = memoryUtilization + "%";
@@ -1384,36 +2972,33 @@
         }
         
         function updateStats() {
-            statContextSwitch.textContent = contextSwitches;
-            statPageFaults.textContent = pageFaults;
-            statDeadlocks.textContent = deadlockCount;
+            statContextSwitch.textContent = simulation.stats.contextSwitches;
+            statPageFaults.textContent = simulation.stats.pageFaults;
+            statDeadlocks.textContent = simulation.stats.deadlocks;
+            
+            // Total deferrals, with the breakdown by reason on hover
+            const deferred = simulation.stats.deferred;
+            statDeferred.textContent = deferred.cpu + deferred.memory + deferred.io + deferred.unsafe + deferred.reservation;
+            statDeferred.title = `CPU: ${deferred.cpu}, Memory: ${deferred.memory}, I/O: ${deferred.io}, Unsafe: ${deferred.unsafe}, Reservation: ${deferred.reservation}`;
         }
         
         function updateTotalProcessesDisplay() {
             totalProcessesElement.textContent = processes.length;
         }
         
-        function updateCharts() {
+        // Build both charts once; later frames only swap in new data
+        function createCharts() {
             // Resource utilization chart
             const resourceCtx = document.getElementById('resource-chart').getContext('2d');
             
-            if (resourceChart) {
-                resourceChart.destroy();
-            }
-            
-            const timeLabels = resourceHistory.map(point => point.time + "s");
-            const cpuData = resourceHistory.map(point => point.cpu);
-            const memoryData = resourceHistory.map(point => point.memory);
-            const ioData = resourceHistory.map(point => point.io);
-            
             resourceChart = new Chart(resourceCtx, {
                 type: 'line',
                 data: {
-                    labels: timeLabels,
+                    labels: [],
                     datasets: [
                         {
                             label: 'CPU Utilization',
-                            data: cpuData,
+                            data: [],
                             borderColor: '#3498db',
                             backgroundColor: 'rgba(52, 152, 219, 0.1)',
                             tension: 0.3,
@@ -1421,7 +3006,7 @@
                         },
                         {
                             label: 'Memory Utilization',
-                            data: memoryData,
+                            data: [],
                             borderColor: '#2ecc71',
                             backgroundColor: 'rgba(46, 204, 113, 0.1)',
                             tension: 0.3,
@@ -1429,7 +3014,7 @@
                         },
                         {
                             label: 'I/O Utilization',
-                            data: ioData,
+                            data: [],
                             borderColor: '#e74c3c',
                             backgroundColor: 'rgba(231, 76, 60, 0.1)',
                             tension: 0.3,
@@ -1462,21 +3047,12 @@
             // Process status chart
             const processCtx = document.getElementById('process-chart').getContext('2d');
             
-            if (processChart) {
-                processChart.destroy();
-            }
-            
             processChart = new Chart(processCtx, {
                 type: 'doughnut',
                 data: {
                     labels: ['Running', 'Waiting', 'Completed', 'Terminated'],
                     datasets: [{
-                        data: [
-                            processStatusCounts.running, 
-                            processStatusCounts.waiting, 
-                            processStatusCounts.completed,
-                            processStatusCounts.terminated
-                        ],
+                        data: [0, 0, 0, 0],
                         backgroundColor: [
                             '#3498db',
                             '#f39c12',
@@ -1498,20 +3074,62 @@
             });
         }
         
+        function updateCharts() {
+            if (!resourceChart) createCharts();
+            
+            resourceChart.data.labels = resourceHistory.map(point => point.time + "s");
+            resourceChart.data.datasets[0].data = resourceHistory.map(point => point.cpu);
+            resourceChart.data.datasets[1].data = resourceHistory.map(point => point.memory);
+            resourceChart.data.datasets[2].data = resourceHistory.map(point => point.io);
+            resourceChart.update('none');
+            
+            processChart.data.datasets[0].data = [
+                processStatusCounts.running,
+                processStatusCounts.waiting,
+                processStatusCounts.completed,
+                processStatusCounts.terminated
+            ];
+            processChart.update('none');
+        }
+        
+        // Queue a log line; it reaches the DOM with the next frame
         function addLog(message, type = "info") {
-            const logEntry = document.createElement("div");
-            logEntry.className = `log-entry log-${type}`;
+            logBuffer.push({ time: simulation.time, message: message, type: type });
+            scheduleRender();
+        }
+        
+        // Append the lines logged since the last frame and drop the oldest
+        // entries beyond the buffer's capacity
+        function flushLog() {
+            const entries = logBuffer.drain();
+            if (entries.length === 0) return;
             
-            const timeStr = simulationTime.toString().padStart(3, '0');
-            logEntry.innerHTML = `<span class="log-time">[${timeStr}s]</span> ${message}`;
+            // Only follow new lines if the user has not scrolled up
+            const atBottom = systemLog.scrollTop + systemLog.clientHeight >= systemLog.scrollHeight - 20;
+            
+            const fragment = document.createDocumentFragment();
+            entries.forEach(entry => {
+                const logEntry = document.createElement("div");
+                logEntry.className = `log-entry log-${entry.type}`;
+                
+                const time = document.createElement("span");
+                time.className = "log-time";
+                time.textContent = `[${entry.time.toString().padStart(3, '0')}s]`;
+                logEntry.append(time, " " + entry.message);
+                fragment.appendChild(logEntry);
+            });
+            systemLog.appendChild(fragment);
             
-            systemLog.appendChild(logEntry);
+            let excess = systemLog.childElementCount - logBuffer.capacity;
+            while (excess-- > 0) {
+                systemLog.firstElementChild.remove();
+            }
             
-            // Auto-scroll to bottom
-            systemLog.scrollTop = systemLog.scrollHeight;
+            if (atBottom) systemLog.scrollTop = systemLog.scrollHeight;
         }
         
         function clearLog() {
+            logBuffer.clear();
             systemLog.innerHTML = "";
         }
         
@@ -1529,44 +3147,14 @@
             const autoAddTime = parseInt(autoAddSelect.value);
             if (autoAddTime > 0) {
                 autoAddInterval = setInterval(() => {
-                    addRandomProcess();
-                    addLog(`Auto-added new process (Total: ${processes.length})`, "info");
+                    addRandomProcess("auto");
                 }, autoAddTime * 1000);
             }
             
-            simulationInterval = setInterval(() => {
-                simulationTime++;
-                simulationTimeElement.textContent = "Time: " + simulationTime + "s";
-                
-                // Update current algorithm display
-                const algorithmText = algorithmSelect.options[algorithmSelect.selectedIndex].text;
-                currentAlgorithmElement.textContent = algorithmText;
-                
-                // Execute simulation step
-                executeProcesses();
-                allocateResources();
-                
-                // Update UI
-                updateProcessList();
-                updateResourceList();
-                updateAllocationTable();
-                updateResourceHistory();
-                updateMetrics();
-                updateStats();
-                updateCharts();
-                
-                // Add periodic log
-                if (simulationTime % 5 === 0) {
-                    addLog(`System check: ${processStatusCounts.running} running, ${processStatusCounts.waiting} waiting, ${processStatusCounts.completed} completed`, "info");
-                }
-                
-                // Check if all processes are completed
-                if (processStatusCounts.completed + processStatusCounts.terminated === processes.length && processes.length > 0) {
-                    addLog("All processes completed. Simulation finished.", "success");
-                    pauseSimulation();
-                }
-                
-            }, parseInt(timeSliceInput.value));
+            // Execute simulation steps; the engine answers each with a delta
+            // and the UI catches up on the next frame
+            lastTickAt = 0;
+            simulationInterval = setInterval(stepSimulation, parseInt(timeSliceInput.value));
         }
         
         function pauseSimulation() {
@@ -1584,6 +3172,74 @@
             addLog("Simulation reset", "info");
         }
         
+        // ==============================
+        // TRACE RECORDING AND PROFILING
+        // ==============================
+        
+        function download(blob, filename) {
+            const link = document.createElement('a');
+            link.href = URL.createObjectURL(blob);
+            link.download = filename;
+            link.click();
+            setTimeout(() => URL.revokeObjectURL(link.href), 1000);
+        }
+        
+        // Where trace chunks go: straight to a file where the browser can
+        // stream to disk, otherwise Blob parts downloaded when recording stops.
+        // Returns null if the user cancels the file picker.
+        async function openTraceSink() {
+            if (window.showSaveFilePicker) {
+                try {
+                    const handle = await window.showSaveFilePicker({ suggestedName: "allocation.trace" });
+                    const writable = await handle.createWritable();
+                    let written = Promise.resolve();
+                    return {
+                        write: chunks => chunks.forEach(chunk => { written = written.then(() => writable.write(chunk)); }),
+                        close: () => written.then(() => writable.close())
+                    };
+                } catch (error) {
+                    if (error.name === "AbortError") return null;
+                }
+            }
+            const parts = [];
+            return {
+                write: chunks => chunks.forEach(chunk => parts.push(chunk)),
+                close: () => download(new Blob(parts, { type: "application/octet-stream" }), "allocation.trace")
+            };
+        }
+        
+        // Recording always starts from a fresh run, since the trace holds the
+        // seed and inputs rather than the state so far
+        async function toggleTraceRecording() {
+            if (traceRecording) {
+                traceRecording = false;
+                traceBtn.innerHTML = '<i class="fas fa-circle"></i> Record Trace';
+                sendToSimulation({ type: "stopTrace" });
+                return;
+            }
+            const sink = await openTraceSink();
+            if (sink === null) return;
+            traceSink = sink;
+            traceRecording = true;
+            traceBtn.innerHTML = '<i class="fas fa-stop"></i> Stop Recording';
+            resetSimulation();
+            addLog("Recording trace from a fresh run", "info");
+        }
+        
+        function finishTrace() {
+            if (traceSink === null) return;
+            traceSink.close();
+            traceSink = null;
+            addLog("Trace saved", "success");
+        }
+        
+        // Worker tick phases and page render phases, folded for flame graph tools
+        function saveProfile(workerProfile) {
+            const folded = [workerProfile, renderProfiler.folded("page")].filter(text => text !== "").join("\n");
+            download(new Blob([folded + "\n"], { type: "text/plain" }), "allocation-profile.folded");
+            addLog("Profile exported", "info");
+        }
+        
         // ==============================
         // ALGORITHM INFORMATION MODAL
         // ==============================
@@ -1646,6 +3302,20 @@
                         <p><strong>Disadvantages:</strong> Poor for short processes, convoy effect</p>
                     `;
                     break;
+                case 'backfill':
+                    details = `
+                        <h3>Backfilling (Multi-Resource Packing) Algorithm</h3>
+                        <p>First come first serve with reservation-based backfilling:</p>
+                        <ul>
+                            <li>Processes start in arrival order until the head of the queue does not fit</li>
+                            <li>The head gets a reserved start time from the running processes' remaining time</li>
+                            <li>Later processes may run ahead if they finish before that time or fit in what it leaves free</li>
+                            <li>Among those, the one whose CPU/memory/I/O needs best match the free resources goes first</li>
+                        </ul>
+                        <p><strong>Advantages:</strong> The head of the queue gets a guaranteed start time, so a large process cannot be passed over indefinitely</p>
+                        <p><strong>Disadvantages:</strong> Keeping resources free for the reservation completes slightly fewer processes, with longer typical waits, than First Come First Serve, which already lets any waiting process that fits run ahead; relies on known burst times and ignores priority</p>
+                    `;
+                    break;
                 default:
                     details = `<p>Algorithm information not available.</p>`;
             }
@@ -1663,8 +3333,20 @@
         resetBtn.addEventListener('click', resetSimulation);
         addProcessBtn.addEventListener('click', addCustomProcess);
         algoInfoBtn.addEventListener('click', showAlgorithmInfo);
+        traceBtn.addEventListener('click', toggleTraceRecording);
+        profileBtn.addEventListener('click', () => sendToSimulation({ type: "profile" }));
         clearLogBtn.addEventListener('click', clearLog);
         
+        // Terminate buttons live in pooled rows, so clicks are handled here
+        processList.addEventListener('click', (event) => {
+            const button = event.target.closest('.terminate-btn');
+            if (button) terminateProcess(Number(button.dataset.processId));
+        });
+        
+        // Scrolling brings different rows into view
+        processList.addEventListener('scroll', scheduleRender);
+        allocationTableViewport.addEventListener('scroll', scheduleRender);
+        
         // Modal close button
         closeModal.addEventListener('click', () => {
             algorithmModal.style.display = 'none';
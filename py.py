@@ -16,13 +16,28 @@ import json
 import time
 import random
 import webbrowser
+import argparse
+import atexit
+import signal
+import struct
+import sys
+from array import array
+from collections import deque
 from datetime import datetime
-from urllib.parse import urlparse
+from urllib.parse import urlparse, parse_qs
 
 PORT = 8000
 TICK_RATE = 1.0
 TOTAL_RAM_MB = 16384
 MAX_HISTORY = 60
+MAX_EVENTS = 100
+PROGRAM_COUNT = 5               # --programs: simulate this many (generated past the initial five)
+MAX_PUBLISHED_PROGRAMS = 200    # programs sent to dashboards per message
+SEED = random.randrange(2**64)  # --seed: programs and demand fluctuation derive from it
+DELTA_BACKLOG = 256      # per-tick deltas kept for ?since= resume
+STREAM_KEEPALIVE = 15.0  # seconds between SSE comments on an idle stream
+LONG_POLL_TIMEOUT = 25.0
+TRACE_FLUSH_SECONDS = 5.0   # a killed --trace run loses at most this much
 
 # ---------- PRIORITY + STATUS ----------
 class Priority:
@@ -48,26 +63,59 @@ INITIAL_PROGRAMS = [
     {"id": 5, "name": "Spotify Music", "priority": Priority.LOW, "cpuDemand": 6.5, "ramDemand": 380.0, "cpuAllocated": 0.0, "ramAllocated": 0.0, "status": ProcessStatus.RUNNING},
 ]
 
+GENERATED_NAMES = ["Service Host", "Background Worker", "Browser Tab", "Indexer", "Updater", "Shell", "Database", "Compiler", "Game", "Sync Client"]
+
+def generatePrograms(count, seed=None):
+    """The initial programs, then random ones up to `count`."""
+    rng = random.Random(seed)
+    progs = [dict(p) for p in INITIAL_PROGRAMS[:count]]
+    priorities = [Priority.REALTIME, Priority.HIGH, Priority.NORMAL, Priority.LOW]
+    for i in range(len(progs), count):
+        progs.append({
+            "id": i + 1,
+            "name": f"{rng.choice(GENERATED_NAMES)} #{i + 1}",
+            "priority": rng.choices(priorities, weights=(2, 18, 60, 20))[0],
+            "cpuDemand": round(rng.uniform(1, 30), 1),
+            "ramDemand": float(rng.randint(200, 4000)),
+            "cpuAllocated": 0.0,
+            "ramAllocated": 0.0,
+            "status": ProcessStatus.RUNNING,
+        })
+    return progs
+
 # ---------- SHARED STATE ----------
+# Writers (simulator, /api/control) hold state_lock only to swap in new
+# values and publish. Readers never take it: they wait on published_changed,
+# which has its own lock, for the next sequence.
 state_lock = threading.Lock()
-programs = [dict(p) for p in INITIAL_PROGRAMS]
+published_changed = threading.Condition(threading.Lock())
+program_table = None   # ProgramTable, written only by the simulator thread
+programs = []          # first MAX_PUBLISHED_PROGRAMS rows as dicts, for JSON
+sim_random = None      # random.Random behind program_table's demand fluctuation
+trace_writer = None    # TraceWriter while --trace is recording
 mode = "Balanced"
 is_running = True
-history = []
-events = []
+history = deque(maxlen=MAX_HISTORY)
+events = deque(maxlen=MAX_EVENTS)   # newest first
 start_time = time.time()
 
+# Immutable (seq, latest Message, ((seq, Message), ...)) replaced on every
+# publish. Handlers read it without locking and never see a partial update.
+published = (0, None, ())
+delta_log = deque(maxlen=DELTA_BACKLOG)
+
 # ---------- SIMULATION LOGIC ----------
-def fluctuateDemand(current, variance, min_v, max_v):
-    change = (random.random() - 0.5) * variance
+def fluctuateDemand(current, variance, min_v, max_v, rand=random.random):
+    change = (rand() - 0.5) * variance
     return max(min_v, min(max_v, current + change))
 
-def calculateAllocation(progs, currentMode):
+# Reference per-dict implementation; the simulator runs allocateTable below
+def calculateAllocation(progs, currentMode, rand=random.random):
     new = [dict(p) for p in progs]
 
     for p in new:
-        p["cpuDemand"] = fluctuateDemand(p["cpuDemand"], 5, 1, 90)
-        p["ramDemand"] = fluctuateDemand(p["ramDemand"], 200, 200, 8000)
+        p["cpuDemand"] = fluctuateDemand(p["cpuDemand"], 5, 1, 90, rand)
+        p["ramDemand"] = fluctuateDemand(p["ramDemand"], 200, 200, 8000, rand)
 
     totalCpu = sum(p["cpuDemand"] for p in new)
     totalRam = sum(p["ramDemand"] for p in new)
@@ -121,6 +169,306 @@ def calculateAllocation(progs, currentMode):
 
     return new
 
+# ---------- TABLE KERNEL ----------
+# Priority and status are stored as indices into these tuples
+PRIORITIES = (Priority.REALTIME, Priority.HIGH, Priority.NORMAL, Priority.LOW)
+STATUSES = (ProcessStatus.RUNNING, ProcessStatus.THROTTLED, ProcessStatus.CRITICAL)
+REALTIME, RUNNING, THROTTLED, CRITICAL = 0, 0, 1, 2
+
+class ProgramTable:
+    """Programs stored column-wise in contiguous arrays."""
+
+    def __init__(self, progs):
+        self.ids = array("q", (p["id"] for p in progs))
+        self.names = [p["name"] for p in progs]
+        self.priority = array("B", (PRIORITIES.index(p["priority"]) for p in progs))
+        self.cpuDemand = array("d", (p["cpuDemand"] for p in progs))
+        self.ramDemand = array("d", (p["ramDemand"] for p in progs))
+        self.cpuAllocated = array("d", (p["cpuAllocated"] for p in progs))
+        self.ramAllocated = array("d", (p["ramAllocated"] for p in progs))
+        self.status = array("B", (STATUSES.index(p["status"]) for p in progs))
+
+    def __len__(self):
+        return len(self.ids)
+
+    def toPrograms(self, limit=None):
+        n = len(self) if limit is None else min(limit, len(self))
+        return [{
+            "id": self.ids[i],
+            "name": self.names[i],
+            "priority": PRIORITIES[self.priority[i]],
+            "cpuDemand": self.cpuDemand[i],
+            "ramDemand": self.ramDemand[i],
+            "cpuAllocated": self.cpuAllocated[i],
+            "ramAllocated": self.ramAllocated[i],
+            "status": STATUSES[self.status[i]],
+        } for i in range(n)]
+
+def modeWeights(currentMode):
+    """CPU share weights indexed by priority code."""
+    return (4 if currentMode == "Performance" else 3,
+            3 if currentMode == "Performance" else 2,
+            1,
+            0.2 if currentMode == "Efficiency" else 0.5)
+
+def priorityShares(currentMode, totalCpu, totalW, totalRam):
+    """(cpu ratio, ram factor or None, status) per priority code.
+
+    Once the totals are known every per-program branch of
+    calculateAllocation depends only on the program's priority: the CPU
+    grant is demand times a per-priority ratio, the RAM cut is one common
+    fraction of demand, and so the status is a per-priority constant.
+    `totalW` is only used when the CPU is oversubscribed.
+    """
+    codes = range(len(PRIORITIES))
+
+    # CPU allocation: min(share * 100, demand) == demand * min(weight * 100 / totalW, 1)
+    if totalCpu <= 100:
+        ratio = (1.0,) * len(codes)
+        status = (RUNNING,) * len(codes)
+    else:
+        weights = modeWeights(currentMode)
+        totalW = totalW or 1e-6
+        ratio = tuple(1.0 if c == REALTIME else min(weights[c] * 100 / totalW, 1.0) for c in codes)
+        status = tuple(RUNNING if c == REALTIME or r >= 0.8 else THROTTLED if r >= 0.4 else CRITICAL
+                       for c, r in zip(codes, ratio))
+
+    # RAM allocation: demand - overflow * demand / totalRam * 1.2 == demand * keep
+    factor = None
+    if totalRam > TOTAL_RAM_MB:
+        keep = 1 - (totalRam - TOTAL_RAM_MB) * 1.2 / totalRam
+        factor = tuple(1.0 if c == REALTIME else keep for c in codes)
+        if keep < 0.9:
+            status = tuple(THROTTLED if c != REALTIME and st == RUNNING else st for c, st in zip(codes, status))
+    return ratio, factor, status
+
+def allocateTable(table, currentMode, rand=random.random):
+    """calculateAllocation over a ProgramTable, updating its columns in place
+    with no per-tick lists or arrays. Random draws are taken in
+    calculateAllocation's order and totals are added up in program order."""
+    cpuD, ramD, prio = table.cpuDemand, table.ramDemand, table.priority
+    cpuA, ramA, status = table.cpuAllocated, table.ramAllocated, table.status
+    weights = modeWeights(currentMode)
+    totalCpu = totalW = totalRam = 0.0
+    for i in range(len(table)):
+        c = max(1.0, min(90.0, cpuD[i] + (rand() - 0.5) * 5.0))
+        r = max(200.0, min(8000.0, ramD[i] + (rand() - 0.5) * 200.0))
+        cpuD[i] = c
+        ramD[i] = r
+        totalCpu += c
+        totalW += weights[prio[i]] * c
+        totalRam += r
+
+    ratio, factor, codeStatus = priorityShares(currentMode, totalCpu, totalW, totalRam)
+    for i in range(len(table)):
+        p = prio[i]
+        cpuA[i] = cpuD[i] * ratio[p]
+        ramA[i] = ramD[i] if factor is None else max(100.0, ramD[i] * factor[p])
+        status[i] = codeStatus[p]
+
+def tableTotals(table):
+    """(total cpu, total ram, throttled programs), added up in program order
+    with += so the totals do not depend on how sum() rounds."""
+    cpu = ram = 0.0
+    for c in table.cpuAllocated:
+        cpu += c
+    for r in table.ramAllocated:
+        ram += r
+    return cpu, ram, len(table) - table.status.count(RUNNING)
+
+def startPrograms(count, seed):
+    """A fresh table and the generator that drives it, both from `seed`."""
+    rng = random.Random(seed)
+    return ProgramTable(generatePrograms(count, seed=rng.getrandbits(64))), rng
+
+def reset_programs():
+    """Start over with PROGRAM_COUNT programs; call with state_lock held."""
+    global program_table, programs, sim_random
+    program_table, sim_random = startPrograms(PROGRAM_COUNT, SEED)
+    programs = program_table.toPrograms(MAX_PUBLISHED_PROGRAMS)
+    if trace_writer is not None:
+        trace_writer.reset()
+
+# ---------- TRACE AND PROFILE ----------
+# A trace is a kind byte per record followed by little-endian fields. The
+# header and resets are enough to regenerate the programs and the random
+# stream, and every tick records its mode and resulting totals, so a replay
+# re-executes the run and checks each tick against the recording. The
+# random module and float results are only guaranteed within one Python
+# version, so the header records it and replay refuses any other.
+TRACE_MAGIC = b"WOTR"
+TRACE_VERSION = 2
+PYTHON_VERSION = sys.version_info[:2]
+MODES = ("Balanced", "Performance", "Efficiency")
+TRACE_HEADER, TRACE_MODE, TRACE_RESET, TRACE_TICK, TRACE_END = 1, 2, 3, 4, 5
+TRACE_RECORDS = {
+    TRACE_HEADER: struct.Struct("<4sBQIBB"), # magic, version, seed, program count, Python major, minor
+    TRACE_MODE: struct.Struct("<B"),         # index into MODES, written when it changes
+    TRACE_RESET: struct.Struct("<"),
+    TRACE_TICK: struct.Struct("<ddI"),       # total cpu, total ram, throttled programs
+    TRACE_END: struct.Struct("<Q"),          # ticks recorded
+}
+
+class TraceWriter:
+    """Appends trace records to a file through a fixed-size buffer, which
+    is also flushed every `flush_seconds` so a killed run keeps its trace."""
+
+    def __init__(self, path, seed, count, buffer_size=65536, flush_seconds=TRACE_FLUSH_SECONDS):
+        self.file = open(path, "wb")
+        self.buffer = bytearray()
+        self.buffer_size = buffer_size
+        self.flush_seconds = flush_seconds
+        self.flushed_at = time.monotonic()
+        self.mode = None
+        self.ticks = 0
+        self.record(TRACE_HEADER, TRACE_MAGIC, TRACE_VERSION, seed, count, *PYTHON_VERSION)
+        self.flush()
+
+    def record(self, kind, *fields):
+        self.buffer.append(kind)
+        self.buffer += TRACE_RECORDS[kind].pack(*fields)
+        if len(self.buffer) >= self.buffer_size:
+            self.flush()
+
+    def flush(self):
+        self.file.write(self.buffer)
+        self.file.flush()
+        self.buffer.clear()
+        self.flushed_at = time.monotonic()
+
+    def reset(self):
+        self.mode = None
+        self.record(TRACE_RESET)
+
+    def tick(self, currentMode, cpu, ram, throttled):
+        if currentMode != self.mode:
+            self.mode = currentMode
+            self.record(TRACE_MODE, MODES.index(currentMode))
+        self.ticks += 1
+        self.record(TRACE_TICK, cpu, ram, throttled)
+        if time.monotonic() - self.flushed_at >= self.flush_seconds:
+            self.flush()
+
+    def close(self):
+        self.record(TRACE_END, self.ticks)
+        self.flush()
+        self.file.close()
+
+class TruncatedTrace(ValueError):
+    """The trace file ends partway through a record."""
+
+def read_trace(path, block_size=1 << 20):
+    """Yield (kind, fields) for each record, reading the file a block at a time."""
+    with open(path, "rb") as f:
+        pending = b""
+        while True:
+            block = f.read(block_size)
+            if not block:
+                break
+            data = pending + block
+            offset = 0
+            while offset < len(data):
+                record = TRACE_RECORDS.get(data[offset])
+                if record is None:
+                    raise ValueError(f"unknown trace record kind {data[offset]}")
+                if offset + 1 + record.size > len(data):
+                    break
+                yield data[offset], record.unpack_from(data, offset + 1)
+                offset += 1 + record.size
+            pending = data[offset:]
+        if pending:
+            raise TruncatedTrace("trace ends inside a record")
+
+def replay_trace(path, profiler=None):
+    """Re-run a trace at full speed, comparing each tick's totals to the recording.
+
+    A trace cut off by a kill has no END record and may end inside a
+    record; every whole tick before that point is still replayed.
+    """
+    table = rand = None
+    currentMode = MODES[0]
+    ticks = divergences = 0
+    first_divergence = None
+    ended = truncated = False
+    start = time.perf_counter()
+    records = read_trace(path)
+    while True:
+        try:
+            kind, fields = next(records)
+        except StopIteration:
+            break
+        except TruncatedTrace:
+            truncated = True
+            break
+        if kind == TRACE_END:
+            ended = True
+        elif kind == TRACE_HEADER:
+            magic, version, seed, count, *python = fields
+            if magic != TRACE_MAGIC or version != TRACE_VERSION:
+                raise ValueError(f"{path} is not a version {TRACE_VERSION} trace")
+            if tuple(python) != PYTHON_VERSION:
+                raise ValueError(f"{path} was recorded on Python {python[0]}.{python[1]}; "
+                                 f"replay it with that version, not {PYTHON_VERSION[0]}.{PYTHON_VERSION[1]}")
+        if kind in (TRACE_HEADER, TRACE_RESET):
+            table, rand = startPrograms(count, seed)
+            currentMode = MODES[0]
+        elif kind == TRACE_MODE:
+            currentMode = MODES[fields[0]]
+        elif kind == TRACE_TICK:
+            if profiler: profiler.begin("tick"); profiler.begin("allocate")
+            allocateTable(table, currentMode, rand.random)
+            if profiler: profiler.end(); profiler.begin("summarize")
+            actual = tableTotals(table)
+            if profiler: profiler.end(); profiler.end()
+            ticks += 1
+            if actual != fields:
+                divergences += 1
+                if first_divergence is None:
+                    first_divergence = {"tick": ticks, "expected": fields, "actual": actual}
+    seconds = time.perf_counter() - start
+    return {"ticks": ticks, "divergences": divergences, "first_divergence": first_divergence,
+            "ended": ended, "truncated": truncated,
+            "seconds": seconds, "ticks_per_second": ticks / seconds if seconds > 0 else float("inf")}
+
+class PhaseProfiler:
+    """Self time per nested begin(name)/end() phase, exported as folded
+    stacks ("tick;allocate 1234", microseconds) for flame graph tools.
+
+    begin/end nest on one thread; add() records a whole top-level phase
+    from any other thread.
+    """
+
+    def __init__(self, clock=time.perf_counter_ns):
+        self.clock = clock
+        self.stack = []   # [stack key, start, time spent in child phases]
+        self.self_time = {}
+        self.lock = threading.Lock()
+
+    def begin(self, name):
+        key = self.stack[-1][0] + ";" + name if self.stack else name
+        self.stack.append([key, self.clock(), 0])
+
+    def end(self):
+        key, start, children = self.stack.pop()
+        elapsed = self.clock() - start
+        self.add(key, elapsed - children)
+        if self.stack:
+            self.stack[-1][2] += elapsed
+
+    def add(self, key, ns):
+        with self.lock:
+            self.self_time[key] = self.self_time.get(key, 0) + ns
+
+    def folded(self, root=None):
+        prefix = root + ";" if root else ""
+        with self.lock:
+            totals = list(self.self_time.items())
+        return "".join(f"{prefix}{stack} {ns // 1000}\n" for stack, ns in totals if ns >= 1000)
+
+# Ticks are timed by the simulator thread; "serialize" is added by whichever
+# client thread first encodes a message, outside the tick. Read by /api/profile
+profiler = PhaseProfiler()
+
 def analyze_system_state():
     with state_lock:
         bott = [p for p in programs if p["status"] in (ProcessStatus.THROTTLED, ProcessStatus.CRITICAL)]
@@ -132,31 +480,120 @@ def analyze_system_state():
     lines.append("- Switch to Performance mode if needed.")
     return "\n".join(lines)
 
+# ---------- PUBLISHING ----------
+class Message:
+    """One published change, serialized to JSON on first use.
+
+    Every message carries the current programs and flags plus what was
+    appended since the previous one. A reset message replaces history and
+    events instead, so the snapshot is simply the reset message for now.
+    The fields are immutable, so whichever reader needs a form first builds
+    it outside state_lock, and the snapshot is only built for clients that
+    connect or fall behind.
+    """
+    __slots__ = ("base", "history", "events", "new_history", "new_events", "reset", "_snapshot", "_delta")
+
+    def __init__(self, base, history, events, new_history, new_events, reset):
+        self.base = base
+        self.history = history
+        self.events = events
+        self.new_history = new_history
+        self.new_events = new_events
+        self.reset = reset
+        self._snapshot = self._delta = None
+
+    def snapshot(self):
+        if self._snapshot is None:
+            start = time.perf_counter_ns()
+            self._snapshot = json.dumps(dict(self.base, reset=True, history=self.history, events=self.events)).encode()
+            profiler.add("serialize", time.perf_counter_ns() - start)
+        return self._snapshot
+
+    def delta(self):
+        if self.reset:
+            return self.snapshot()
+        if self._delta is None:
+            start = time.perf_counter_ns()
+            self._delta = json.dumps(dict(self.base, reset=False, history=self.new_history, events=self.new_events)).encode()
+            profiler.add("serialize", time.perf_counter_ns() - start)
+        return self._delta
+
+def publish(new_history=(), new_events=(), reset=False):
+    """Hand the state to every client; call with state_lock held.
+
+    Only shallow copies are taken here; serializing is left to the readers.
+    """
+    global published
+    seq = published[0] + 1
+    base = {
+        "seq": seq,
+        "programs": programs,
+        "mode": mode,
+        "is_running": is_running,
+        "total_threads": len(program_table)*12,
+        "uptime_seconds": int(time.time()-start_time),
+        "max_history": MAX_HISTORY,
+        "max_events": MAX_EVENTS,
+    }
+    message = Message(base, list(history), list(events), list(new_history), list(new_events), reset)
+    delta_log.append((seq, message))
+    published = (seq, message, tuple(delta_log))
+    with published_changed:
+        published_changed.notify_all()
+
+def messages_since(since):
+    """Messages a client that has seen `since` needs, and the last seq."""
+    seq, latest, deltas = published
+    if since is None or since > seq or not deltas or since < deltas[0][0] - 1:
+        return [latest.snapshot()], seq
+    return [message.delta() for s, message in deltas[since - deltas[0][0] + 1:]], seq
+
+def wait_for_update(since, timeout):
+    with published_changed:
+        published_changed.wait_for(lambda: published[0] != since, timeout)
+
 # ---------- SIMULATION THREAD ----------
 def sim_thread_fn():
-    global programs, history, events
+    global programs
     while True:
         time.sleep(TICK_RATE)
         with state_lock:
             if not is_running:
                 continue
-            programs = calculateAllocation(programs, mode)
-            cpu = sum(p["cpuAllocated"] for p in programs)
-            ram = sum(p["ramAllocated"] for p in programs)
-            thr = sum(1 for p in programs if p["status"] in (ProcessStatus.THROTTLED, ProcessStatus.CRITICAL))
-            ts = nowtime()
-            history.append({"time": ts, "cpuUsage": cpu, "ramUsage": ram / 1024.0, "bottlenecks": thr})
-            if len(history) > MAX_HISTORY:
-                history.pop(0)
-            if thr > 0:
-                events.insert(0, f"Resource Contention: {thr} processes throttled at {ts}")
-            else:
-                if random.random() < 0.02:
-                    events.insert(0, f"System Nominal at {ts}")
-            if len(events) > 100:
-                events = events[:100]
+            table, rand, currentMode = program_table, sim_random, mode
+
+        # Only this thread writes the table; readers see the published
+        # `programs` dicts, which are rebuilt below (copy-on-write)
+        profiler.begin("tick")
+        profiler.begin("allocate")
+        allocateTable(table, currentMode, rand.random)
+        profiler.end()
+        profiler.begin("summarize")
+        new = table.toPrograms(MAX_PUBLISHED_PROGRAMS)
+        cpu, ram, thr = tableTotals(table)
+        profiler.end()
+        ts = nowtime()
+        point = {"time": ts, "cpuUsage": cpu, "ramUsage": ram / 1024.0, "bottlenecks": thr}
+        new_events = []
+        if thr > 0:
+            new_events.append(f"Resource Contention: {thr} processes throttled at {ts}")
+        else:
+            if random.random() < 0.02:
+                new_events.append(f"System Nominal at {ts}")
 
-threading.Thread(target=sim_thread_fn, daemon=True).start()
+        with state_lock:
+            if program_table is not table:
+                profiler.end()
+                continue   # reset while computing; drop this tick
+            if trace_writer is not None:
+                trace_writer.tick(currentMode, cpu, ram, thr)
+            programs = new
+            history.append(point)
+            events.extendleft(new_events)
+            profiler.begin("publish")
+            publish([point], new_events)
+            profiler.end()
+        profiler.end()
 
 # ---------- EMBEDDED HTML PAGE WITH HEIGHT FIX ----------
 PAGE = r"""
@@ -265,6 +702,9 @@ PAGE = r"""
 const POLL_MS = 1000;
 let chart = null;
 
+// Client copy of the server state, kept current from streamed deltas
+const state = { seq: null, programs: [], history: [], events: [], maxHistory: 60, maxEvents: 100 };
+
 function initChart(){
   const ctx = document.getElementById('historyChart');
   chart = new Chart(ctx, {
@@ -284,10 +724,44 @@ function initChart(){
   });
 }
 
-async function fetchState(){
-  const res = await fetch('/api/state');
-  const data = await res.json();
-  applyState(data);
+function applyMessage(msg){
+  if(msg.reset){
+    state.history = [];
+    state.events = [];
+    state.maxHistory = msg.max_history;
+    state.maxEvents = msg.max_events;
+  }
+  state.seq = msg.seq;
+  state.programs = msg.programs;
+  state.history.push(...msg.history);
+  if(state.history.length > state.maxHistory) state.history.splice(0, state.history.length - state.maxHistory);
+  // New events arrive oldest first; the list shows newest first
+  state.events.unshift(...msg.events.slice().reverse());
+  if(state.events.length > state.maxEvents) state.events.length = state.maxEvents;
+}
+
+// Server-Sent Events resume from Last-Event-ID on reconnect; without
+// EventSource fall back to long-polling with ?since=
+function connectStream(){
+  if(window.EventSource){
+    const source = new EventSource('/api/stream');
+    source.onmessage = e=>{ applyMessage(JSON.parse(e.data)); applyState(state); };
+    return;
+  }
+  pollState();
+}
+
+async function pollState(){
+  try{
+    const query = state.seq === null ? '' : '?since='+state.seq;
+    const res = await fetch('/api/state'+query);
+    const data = await res.json();
+    (Array.isArray(data) ? data : [data]).forEach(applyMessage);
+    applyState(state);
+    setTimeout(pollState, 0);
+  }catch(e){
+    setTimeout(pollState, POLL_MS);
+  }
 }
 
 function applyState(data){
@@ -371,8 +845,7 @@ document.getElementById('analyzeBtn').onclick = async ()=>{
 
 window.onload = ()=>{
   initChart();
-  fetchState();
-  setInterval(fetchState, POLL_MS);
+  connectStream();
 };
 </script>
 
@@ -396,23 +869,64 @@ class Handler(http.server.BaseHTTPRequestHandler):
             return
 
         if parsed.path == "/api/state":
-            with state_lock:
-                data = {
-                    "programs": programs,
-                    "history": history,
-                    "events": events[:50],
-                    "mode": mode,
-                    "is_running": is_running,
-                    "total_threads": len(programs)*12,
-                    "uptime_seconds": int(time.time()-start_time),
-                }
+            # Plain GET: the current snapshot. ?since=seq: long-poll until
+            # something newer exists, then the messages after seq as a list.
+            since = self._since(parsed)
+            if since is None:
+                body = published[1].snapshot()
+            else:
+                if since == published[0]:
+                    wait_for_update(since, LONG_POLL_TIMEOUT)
+                messages, _ = messages_since(since)
+                body = b"[" + b",".join(messages) + b"]"
             self._send(200,"application/json")
-            self.wfile.write(json.dumps(data).encode())
+            self.wfile.write(body)
+            return
+
+        if parsed.path == "/api/stream":
+            self._stream(self._since(parsed))
+            return
+
+        if parsed.path == "/api/profile":
+            # Simulator tick phases and message serializing so far, folded
+            # for flame graph tools
+            self._send(200,"text/plain")
+            self.wfile.write(profiler.folded("simulator").encode())
             return
 
         self._send(404,"text/plain")
         self.wfile.write(b"Not Found")
 
+    def _since(self, parsed):
+        value = parse_qs(parsed.query).get("since", [self.headers.get("Last-Event-ID")])[0]
+        try: return int(value)
+        except (TypeError, ValueError): return None
+
+    def _stream(self, since):
+        """Server-Sent Events: one event per published message, id = seq."""
+        self.send_response(200)
+        self.send_header("Content-Type", "text/event-stream")
+        self.send_header("Cache-Control", "no-cache")
+        self.send_header("Access-Control-Allow-Origin","*")
+        self.end_headers()
+        try:
+            while True:
+                messages, seq = messages_since(since)
+                if since == seq:
+                    self.wfile.write(b": keepalive\n\n")
+                else:
+                    # A snapshot or a run of deltas all end at `seq`
+                    chunks = [b"data: " + m + b"\n\n" for m in messages[:-1]]
+                    chunks.append(b"id: %d\ndata: " % seq + messages[-1] + b"\n\n")
+                    self.wfile.write(b"".join(chunks))
+                    since = seq
+                wait_for_update(since, STREAM_KEEPALIVE)
+        except (BrokenPipeError, ConnectionResetError, ConnectionAbortedError):
+            return
+
+    def log_message(self, format, *args):
+        pass  # hundreds of streaming clients would flood the console
+
     def do_POST(self):
         parsed = urlparse(self.path)
         if parsed.path == "/api/control":
@@ -421,18 +935,19 @@ class Handler(http.server.BaseHTTPRequestHandler):
             try: data = json.loads(body)
             except: data = {}
 
-            global is_running, programs, mode, history, events
+            global is_running, mode
             action = data.get("action")
             with state_lock:
                 if action=="pause": is_running=False
                 elif action=="resume": is_running=True
                 elif action=="reset":
-                    programs = [dict(p) for p in INITIAL_PROGRAMS]
+                    reset_programs()
                     history.clear(); events.clear()
                 elif action=="mode":
                     m = data.get("mode")
-                    if m in ("Balanced","Performance","Efficiency"):
+                    if m in MODES:
                         mode = m
+                publish(reset=(action=="reset"))
 
             self._send(200,"application/json")
             self.wfile.write(json.dumps({"ok":True}).encode())
@@ -448,11 +963,109 @@ class Handler(http.server.BaseHTTPRequestHandler):
         self.wfile.write(b"Not Found")
 
 
+class DashboardServer(socketserver.ThreadingTCPServer):
+    # One thread per connection; idle streams just park in published_changed.wait
+    daemon_threads = True
+    allow_reuse_address = True
+    request_queue_size = 512
+
 def run_server():
-    with socketserver.ThreadingTCPServer(("", PORT), Handler) as httpd:
+    with DashboardServer(("", PORT), Handler) as httpd:
         print(f"Running at http://127.0.0.1:{PORT}")
         httpd.serve_forever()
 
+# ---------- MICROBENCHMARK ----------
+def run_benchmark(sizes, ticks):
+    """Per-tick cost of calculateAllocation vs allocateTable by program count."""
+    print(f"{'programs':>9}  {'dict ms/tick':>12}  {'table ms/tick':>13}  {'speedup':>7}  {'max diff':>8}")
+    for n in sizes:
+        progs = generatePrograms(n, seed=1)
+        table = ProgramTable(progs)
+        mode_ = "Balanced"
+
+        # Both versions draw from identically seeded generators, so their
+        # results must agree up to float rounding
+        rng = random.Random(1)
+        start = time.perf_counter()
+        for _ in range(ticks):
+            allocateTable(table, mode_, rng.random)
+        tabled = (time.perf_counter() - start) / ticks
+
+        reference, diff = None, None
+        if n <= 100000:
+            rng = random.Random(1)
+            start = time.perf_counter()
+            for _ in range(ticks):
+                progs = calculateAllocation(progs, mode_, rng.random)
+            reference = (time.perf_counter() - start) / ticks
+            expected = ProgramTable(progs)
+            assert expected.status == table.status, f"status mismatch at {n} programs"
+            diff = max(max(abs(a - b) for a, b in zip(getattr(expected, column), getattr(table, column)))
+                       for column in ("cpuDemand", "ramDemand", "cpuAllocated", "ramAllocated"))
+
+        print(f"{n:>9}  {reference * 1000 if reference else float('nan'):>12.3f}  {tabled * 1000:>13.3f}  "
+              f"{reference / tabled if reference else float('nan'):>7.1f}  {diff if diff is not None else float('nan'):>8.1e}")
+
 if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="WinOptima resource manager")
+    parser.add_argument("--programs", type=int, default=PROGRAM_COUNT, help="number of simulated programs")
+    parser.add_argument("--benchmark", action="store_true", help="time the allocation kernels and exit")
+    parser.add_argument("--sizes", default="5,50,500,5000,50000,100000,1000000", help="program counts for --benchmark")
+    parser.add_argument("--ticks", type=int, default=5, help="ticks per size for --benchmark")
+    parser.add_argument("--seed", type=int, help="seed for the programs and their demand (default: random)")
+    parser.add_argument("--trace", metavar="FILE", help="record every tick to a binary trace")
+    parser.add_argument("--replay", metavar="FILE", help="re-run a trace at full speed, check it and exit")
+    parser.add_argument("--profile", metavar="FILE", help="write per-phase tick timings as folded stacks on exit")
+    args = parser.parse_args()
+
+    if args.benchmark:
+        run_benchmark([int(n) for n in args.sizes.split(",")], args.ticks)
+        raise SystemExit
+
+    if args.replay:
+        replay_profiler = PhaseProfiler()
+        summary = replay_trace(args.replay, replay_profiler)
+        if args.profile:
+            with open(args.profile, "w") as f:
+                f.write(replay_profiler.folded("replay"))
+        print(f"{summary['ticks']} ticks in {summary['seconds']:.2f}s ({summary['ticks_per_second']:.0f} ticks/s), "
+              f"{summary['divergences']} divergent")
+        if not summary["ended"]:
+            print("Trace has no END record" + (" and ends inside a record" if summary["truncated"] else "")
+                  + "; the recording was cut off")
+        if summary["first_divergence"]:
+            print(f"First divergence: {summary['first_divergence']}")
+        raise SystemExit(1 if summary["divergences"] else 0)
+
+    with state_lock:
+        PROGRAM_COUNT = args.programs
+        if args.seed is not None:
+            SEED = args.seed
+        reset_programs()
+        history.clear(); events.clear()
+        if args.trace:
+            trace_writer = TraceWriter(args.trace, SEED, PROGRAM_COUNT)
+        publish(reset=True)
+
+    def close_trace():
+        global trace_writer
+        with state_lock:
+            if trace_writer is not None:
+                trace_writer.close()
+                trace_writer = None
+
+    # SIGTERM unwinds like Ctrl+C, and any other exit still ends the trace
+    atexit.register(close_trace)
+    signal.signal(signal.SIGTERM, lambda signum, frame: sys.exit(128 + signum))
+
+    threading.Thread(target=sim_thread_fn, daemon=True).start()
     threading.Thread(target=lambda: (time.sleep(0.5), webbrowser.open(f"http://127.0.0.1:{PORT}")), daemon=True).start()
-    run_server()
\ No newline at end of file
+    try:
+        run_server()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        close_trace()
+        if args.profile:
+            with open(args.profile, "w") as f:
+                f.write(profiler.folded("simulator"))
\ No newline at end of file
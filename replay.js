@@ -0,0 +1,102 @@
+#!/usr/bin/env node
+// Deterministic replay of a binary trace recorded by the page (Record Trace)
+// or by benchmark.js --trace.
+//
+// The trace holds each run's seed, resources and inputs, so the run is
+// re-executed on the engine loaded from the page at full speed, with no
+// timers or rendering. Every grant, completion and deadlock victim recorded
+// in the trace is checked against the replay; the exit status is 1 if any
+// of them differ.
+//
+//   node replay.js FILE [options]
+//
+//   --profile FILE           write per-phase tick timings as folded stacks
+//   --page FILE              page to load the engine from (default project.html)
+//   --json                   print the summary as JSON
+
+const fs = require("fs");
+const path = require("path");
+const { loadEngine } = require("./benchmark");
+
+const READ_SIZE = 1 << 20;
+
+function parseArgs(argv) {
+    const config = { trace: null, profile: null, page: path.join(__dirname, "project.html"), json: false };
+
+    for (let i = 0; i < argv.length; i++) {
+        const flag = argv[i];
+        const value = argv[i + 1];
+        switch (flag) {
+            case "--profile": config.profile = value; i++; break;
+            case "--page": config.page = value; i++; break;
+            case "--json": config.json = true; break;
+            default:
+                if (flag.startsWith("--") || config.trace !== null) throw new Error(`Unknown option ${flag}`);
+                config.trace = flag;
+        }
+    }
+
+    if (config.trace === null) throw new Error("Usage: node replay.js FILE [--profile FILE] [--page FILE] [--json]");
+    return config;
+}
+
+// Feed the trace through `replay` a block at a time, so memory stays flat however long it is
+function replayFile(engineModule, file, replay) {
+    const reader = new engineModule.TraceReader();
+    const fd = fs.openSync(file, "r");
+    const block = new Uint8Array(READ_SIZE);
+    let bytes = 0;
+    try {
+        for (;;) {
+            const read = fs.readSync(fd, block, 0, READ_SIZE, null);
+            if (read === 0) break;
+            bytes += read;
+            reader.push(block.subarray(0, read)).forEach(record => replay.apply(record));
+        }
+    } finally {
+        fs.closeSync(fd);
+    }
+    reader.finish();
+    replay.settle();
+    return bytes;
+}
+
+function main() {
+    const config = parseArgs(process.argv.slice(2));
+    const engineModule = loadEngine(config.page);
+    const profiler = config.profile ? new engineModule.PhaseProfiler() : null;
+    const replay = new engineModule.TraceReplay(profiler);
+
+    const start = process.hrtime.bigint();
+    const bytes = replayFile(engineModule, config.trace, replay);
+    const seconds = Number(process.hrtime.bigint() - start) / 1e9;
+
+    if (profiler) fs.writeFileSync(config.profile, profiler.folded("replay") + "\n");
+
+    const summary = {
+        bytes: bytes,
+        runs: replay.runs,
+        ticks: replay.ticks,
+        checked: replay.checked,
+        divergences: replay.divergences,
+        firstDivergence: replay.firstDivergence,
+        wallSeconds: seconds,
+        ticksPerSecond: seconds > 0 ? replay.ticks / seconds : Infinity
+    };
+    if (config.json) {
+        console.log(JSON.stringify(summary, null, 2));
+    } else {
+        console.log(`${summary.runs} run(s), ${summary.ticks} ticks, ${summary.bytes} bytes in ${seconds.toFixed(2)}s ` +
+            `(${Math.round(summary.ticksPerSecond)} ticks/s)`);
+        console.log(`${summary.checked} recorded events checked, ${summary.divergences} divergent`);
+        if (summary.firstDivergence) {
+            console.log(`First divergence at t=${summary.firstDivergence.time}: ` +
+                `expected ${JSON.stringify(summary.firstDivergence.expected)}, got ${JSON.stringify(summary.firstDivergence.actual)}`);
+        }
+    }
+    process.exitCode = replay.divergences > 0 ? 1 : 0;
+}
+
+if (require.main === module) {
+    main();
+}
@@ -0,0 +1,411 @@
+#!/usr/bin/env node
+// Parallel Monte Carlo parameter sweep over the headless engine (see benchmark.js).
+//
+// Every combination of the grid below is simulated once per seed. Runs are
+// spread over worker threads; each worker owns a deque of runs and steals from
+// the back of the fullest deque once its own is empty. Whenever all seeds of
+// a grid point have finished, its aggregated row is appended to the output
+// file (CSV, or one JSON object per line for any other extension).
+//
+// Finished runs are journaled to <out>.journal as they complete. If a sweep is
+// interrupted, running the same command again skips them and carries on; the
+// journal is removed once the sweep finishes. The journal starts with the run
+// options that are not part of a grid point, and resuming with different ones
+// is refused rather than mixing incomparable runs.
+//
+//   node sweep.js --out results.csv [options]
+//
+//   --algorithms a,b            algorithms to compare (default all five)
+//   --size N                    initial process count per run (default 1000)
+//   --cpu 2,4                   grid values for CPU cores (default 2)
+//   --memory 512,1024           grid values for memory in MB (default 512)
+//   --io 3                      grid values for I/O devices (default 3)
+//   --arrival-every 0,5         grid values for the auto-add rate in ticks (default 0)
+//   --deadlock on,avoid         grid values for the deadlock mode: on, avoid, off (default on)
+//   --seeds N                   seeds per grid point (default 8)
+//   --seed N                    first seed (default 1)
+//   --max-ticks N               tick limit per run (default 20000)
+//   --jobs N                    worker threads (default: all cores)
+
+const fs = require("fs");
+const os = require("os");
+const { Worker, isMainThread, parentPort, workerData } = require("worker_threads");
+const { ALGORITHMS, DEADLOCK_MODES, DEFAULTS, loadEngine, runSimulation, deferredTotal } = require("./benchmark");
+
+const PERCENTILES = [50, 95, 99];
+
+const COLUMNS = [
+    "algorithm", "size", "cpu", "memory", "io", "arrivalEvery", "deadlockMode", "seeds",
+    "wait_p50", "wait_p95", "wait_p99", "turnaround_p50", "turnaround_p95", "turnaround_p99",
+    "deadlocks_total", "deadlocks_mean", "deferred_mean", "deferred_unsafe_total",
+    "completed_mean", "throughput_mean", "ticks_mean",
+    "util_cpu_mean", "util_memory_mean", "util_io_mean"
+];
+
+// ==============================
+// WORKER
+// ==============================
+
+// Sparse [value, count] pairs for integer tick values
+function histogram(values) {
+    const counts = new Map();
+    values.forEach(value => counts.set(value, (counts.get(value) || 0) + 1));
+    return Array.from(counts.entries());
+}
+
+function runTask(engineModule, task) {
+    const point = task.point;
+    const config = Object.assign({}, DEFAULTS, {
+        seed: task.seed,
+        maxTicks: task.maxTicks,
+        cpu: point.cpu,
+        memory: point.memory,
+        io: point.io,
+        arrivalEvery: point.arrivalEvery,
+        deadlock: point.deadlockMode
+    });
+
+    let waits = [];
+    let turnarounds = [];
+    const result = runSimulation(engineModule, config, point.algorithm, point.size, engine => {
+        waits = engine.processes.map(process => engine.scheduler.waitTimeOf(process));
+        turnarounds = engine.processes
+            .filter(process => process.status === "completed")
+            .map(process => process.completionTime - process.arrivalTime);
+    });
+
+    return {
+        key: task.key,
+        seed: task.seed,
+        summary: {
+            completed: result.completed,
+            deadlocks: result.deadlocks,
+            deferred: deferredTotal(result.deferred),
+            deferredUnsafe: result.deferred.unsafe,
+            ticks: result.ticks,
+            throughputPerMin: result.throughputPerMin,
+            utilCPU: result.utilization.cpu,
+            utilMemory: result.utilization.memory,
+            utilIO: result.utilization.io
+        },
+        wait: histogram(waits),
+        turnaround: histogram(turnarounds)
+    };
+}
+
+function workerMain() {
+    const engineModule = loadEngine(workerData.page);
+    parentPort.on("message", task => {
+        parentPort.postMessage(runTask(engineModule, task));
+    });
+}
+
+// ==============================
+// COORDINATOR
+// ==============================
+
+function parseArgs(argv) {
+    const config = {
+        out: null,
+        algorithms: ALGORITHMS,
+        size: 1000,
+        cpu: [DEFAULTS.cpu],
+        memory: [DEFAULTS.memory],
+        io: [DEFAULTS.io],
+        arrivalEvery: [0],
+        deadlockMode: ["on"],
+        seeds: 8,
+        seed: 1,
+        maxTicks: DEFAULTS.maxTicks,
+        jobs: os.availableParallelism ? os.availableParallelism() : os.cpus().length,
+        page: DEFAULTS.page
+    };
+    const list = value => value.split(",").filter(item => item !== "");
+    const numbers = value => list(value).map(Number);
+
+    for (let i = 0; i < argv.length; i += 2) {
+        const flag = argv[i];
+        const value = argv[i + 1];
+        switch (flag) {
+            case "--out": config.out = value; break;
+            case "--algorithms": config.algorithms = list(value); break;
+            case "--size": config.size = Number(value); break;
+            case "--cpu": config.cpu = numbers(value); break;
+            case "--memory": config.memory = numbers(value); break;
+            case "--io": config.io = numbers(value); break;
+            case "--arrival-every": config.arrivalEvery = numbers(value); break;
+            case "--deadlock": config.deadlockMode = list(value); break;
+            case "--seeds": config.seeds = Number(value); break;
+            case "--seed": config.seed = Number(value); break;
+            case "--max-ticks": config.maxTicks = Number(value); break;
+            case "--jobs": config.jobs = Number(value); break;
+            case "--page": config.page = value; break;
+            default:
+                throw new Error(`Unknown option ${flag}`);
+        }
+    }
+
+    if (!config.out) throw new Error("--out FILE is required");
+    config.algorithms.forEach(algorithm => {
+        if (!ALGORITHMS.includes(algorithm)) throw new Error(`Unknown algorithm ${algorithm}`);
+    });
+    config.deadlockMode.forEach(mode => {
+        if (!DEADLOCK_MODES.includes(mode)) throw new Error(`Unknown deadlock mode ${mode}`);
+    });
+    return config;
+}
+
+// Cartesian product of the grid, in a stable order
+function gridPoints(config) {
+    const points = [];
+    config.algorithms.forEach(algorithm =>
+        config.cpu.forEach(cpu =>
+            config.memory.forEach(memory =>
+                config.io.forEach(io =>
+                    config.arrivalEvery.forEach(arrivalEvery =>
+                        config.deadlockMode.forEach(deadlockMode =>
+                            points.push({ algorithm, size: config.size, cpu, memory, io, arrivalEvery, deadlockMode })))))));
+    return points;
+}
+
+function pointKey(point) {
+    return COLUMNS.slice(0, 7).map(column => point[column]).join("/");
+}
+
+// Options every run of the sweep shares; they change results but are not in pointKey
+function runOptions(config) {
+    return { maxTicks: config.maxTicks, page: config.page };
+}
+
+function percentile(histogramCounts, total, p) {
+    if (total === 0) return 0;
+    const rank = Math.ceil((p / 100) * total);
+    const values = Array.from(histogramCounts.keys()).sort((a, b) => a - b);
+    let seen = 0;
+    for (const value of values) {
+        seen += histogramCounts.get(value);
+        if (seen >= rank) return value;
+    }
+    return values[values.length - 1];
+}
+
+// Running aggregate of every finished seed of one grid point
+class PointAggregate {
+    constructor(point) {
+        this.point = point;
+        this.runs = 0;
+        this.wait = new Map();
+        this.waitTotal = 0;
+        this.turnaround = new Map();
+        this.turnaroundTotal = 0;
+        this.sums = { completed: 0, deadlocks: 0, deferred: 0, deferredUnsafe: 0, ticks: 0, throughputPerMin: 0,
+            utilCPU: 0, utilMemory: 0, utilIO: 0 };
+    }
+
+    add(run) {
+        this.runs++;
+        run.wait.forEach(([value, count]) => {
+            this.wait.set(value, (this.wait.get(value) || 0) + count);
+            this.waitTotal += count;
+        });
+        run.turnaround.forEach(([value, count]) => {
+            this.turnaround.set(value, (this.turnaround.get(value) || 0) + count);
+            this.turnaroundTotal += count;
+        });
+        Object.keys(this.sums).forEach(field => { this.sums[field] += run.summary[field]; });
+    }
+
+    row() {
+        const row = Object.assign({}, this.point, { seeds: this.runs });
+        PERCENTILES.forEach(p => {
+            row[`wait_p${p}`] = percentile(this.wait, this.waitTotal, p);
+            row[`turnaround_p${p}`] = percentile(this.turnaround, this.turnaroundTotal, p);
+        });
+        row.deadlocks_total = this.sums.deadlocks;
+        row.deadlocks_mean = this.sums.deadlocks / this.runs;
+        row.deferred_mean = this.sums.deferred / this.runs;
+        row.deferred_unsafe_total = this.sums.deferredUnsafe;
+        row.completed_mean = this.sums.completed / this.runs;
+        row.throughput_mean = this.sums.throughputPerMin / this.runs;
+        row.ticks_mean = this.sums.ticks / this.runs;
+        row.util_cpu_mean = this.sums.utilCPU / this.runs;
+        row.util_memory_mean = this.sums.utilMemory / this.runs;
+        row.util_io_mean = this.sums.utilIO / this.runs;
+        return row;
+    }
+}
+
+class ResultWriter {
+    constructor(file) {
+        this.file = file;
+        this.csv = file.endsWith(".csv");
+        fs.writeFileSync(file, this.csv ? COLUMNS.join(",") + "\n" : "");
+    }
+
+    write(row) {
+        const line = this.csv ?
+            COLUMNS.map(column => typeof row[column] === "number" && !Number.isInteger(row[column]) ?
+                row[column].toFixed(3) : row[column]).join(",") :
+            JSON.stringify(row);
+        fs.appendFileSync(this.file, line + "\n");
+    }
+}
+
+// Hands out tasks from per-worker deques: a worker takes from the front of
+// its own deque and, when that is empty, steals from the back of the fullest
+class WorkStealingQueue {
+    constructor(tasks, workerCount) {
+        this.deques = Array.from({ length: workerCount }, () => []);
+        tasks.forEach((task, index) => this.deques[index % workerCount].push(task));
+        this.steals = 0;
+    }
+
+    next(workerIndex) {
+        const own = this.deques[workerIndex];
+        if (own.length > 0) return own.shift();
+
+        let victim = null;
+        this.deques.forEach(deque => {
+            if (deque.length > 0 && (victim === null || deque.length > victim.length)) victim = deque;
+        });
+        if (victim === null) return undefined;
+        this.steals++;
+        return victim.pop();
+    }
+}
+
+function coordinatorMain() {
+    const config = parseArgs(process.argv.slice(2));
+    const journalFile = config.out + ".journal";
+    const points = gridPoints(config);
+    const aggregates = new Map(points.map(point => [pointKey(point), new PointAggregate(point)]));
+    const writer = new ResultWriter(config.out);
+
+    // Replay the journal of an interrupted sweep
+    const done = new Set();
+    const options = JSON.stringify(runOptions(config));
+    let resuming = false;
+    if (fs.existsSync(journalFile)) {
+        const lines = fs.readFileSync(journalFile, "utf8").split("\n");
+        if (lines[0].trim() !== "") {
+            let header = null;
+            try {
+                header = JSON.parse(lines[0]).options;
+            } catch (error) {
+                // Reported below as a journal without a header
+            }
+            if (!header) {
+                throw new Error(`${journalFile} has no options header; delete it to start the sweep over`);
+            }
+            if (JSON.stringify(header) !== options) {
+                throw new Error(`${journalFile} was written with ${JSON.stringify(header)}, not ${options}; ` +
+                    "rerun with the same options or delete it to start over");
+            }
+            resuming = true;
+        }
+        lines.slice(1).forEach(line => {
+            if (line.trim() === "") return;
+            let run;
+            try {
+                run = JSON.parse(line);
+            } catch (error) {
+                return; // Torn last line from the interruption
+            }
+            const aggregate = aggregates.get(run.key);
+            if (!aggregate || done.has(run.key + "#" + run.seed)) return;
+            done.add(run.key + "#" + run.seed);
+            aggregate.add(run);
+        });
+        if (resuming) process.stderr.write(`Resuming: ${done.size} runs already in ${journalFile}\n`);
+    }
+
+    const finishPoint = aggregate => {
+        writer.write(aggregate.row());
+        aggregates.delete(pointKey(aggregate.point));
+    };
+
+    const tasks = [];
+    points.forEach(point => {
+        const key = pointKey(point);
+        for (let i = 0; i < config.seeds; i++) {
+            const seed = config.seed + i;
+            if (!done.has(key + "#" + seed)) tasks.push({ key, point, seed, maxTicks: config.maxTicks });
+        }
+        if (aggregates.get(key).runs === config.seeds) finishPoint(aggregates.get(key));
+    });
+
+    const total = tasks.length;
+    if (total === 0) {
+        if (fs.existsSync(journalFile)) fs.unlinkSync(journalFile);
+        process.stderr.write(`Nothing to run; results in ${config.out}\n`);
+        return;
+    }
+
+    const journal = fs.openSync(journalFile, resuming ? "a" : "w");
+    if (!resuming) fs.writeSync(journal, JSON.stringify({ options: runOptions(config) }) + "\n");
+    const queue = new WorkStealingQueue(tasks, Math.max(1, Math.min(config.jobs, total)));
+    const workers = [];
+    const started = Date.now();
+    let finished = 0;
+    let stopping = false;
+
+    const shutdown = () => {
+        workers.forEach(worker => worker.terminate());
+        fs.closeSync(journal);
+    };
+
+    const dispatch = (worker, index) => {
+        const task = stopping ? undefined : queue.next(index);
+        if (task !== undefined) {
+            worker.postMessage(task);
+        } else {
+            worker.idle = true;
+            if (workers.every(w => w.idle)) {
+                shutdown();
+                if (stopping) {
+                    process.exitCode = 130;
+                } else {
+                    fs.unlinkSync(journalFile);
+                    process.stderr.write(`\nFinished ${total} runs in ${((Date.now() - started) / 1000).toFixed(1)}s ` +
+                        `(${queue.steals} steals); results in ${config.out}\n`);
+                }
+            }
+        }
+    };
+
+    for (let index = 0; index < queue.deques.length; index++) {
+        const worker = new Worker(__filename, { workerData: { page: config.page } });
+        worker.idle = false;
+        worker.on("message", run => {
+            fs.writeSync(journal, JSON.stringify(run) + "\n");
+            finished++;
+
+            const aggregate = aggregates.get(run.key);
+            aggregate.add(run);
+            if (aggregate.runs === config.seeds) finishPoint(aggregate);
+
+            process.stderr.write(`\r${finished}/${total} runs`);
+            dispatch(worker, index);
+        });
+        worker.on("error", error => {
+            stopping = true;
+            shutdown();
+            throw error;
+        });
+        workers.push(worker);
+        dispatch(worker, index);
+    }
+
+    // Let in-flight runs land in the journal, then stop; rerun to resume
+    process.on("SIGINT", () => {
+        if (stopping) process.exit(130);
+        stopping = true;
+        process.stderr.write(`\nInterrupted after ${finished}/${total} runs; rerun the same command to resume\n`);
+    });
+}
+
+if (isMainThread) {
+    coordinatorMain();
+} else {
+    workerMain();
+}